@@ -49,10 +49,11 @@ function splitNonEmpty(s, c) { return s.split(c).filter(function(e) { return e;
 function toNative(p) { return FileInfo.toNativeSeparators(p); }
 function exeSuffix(qbs) { return qbs.hostOS.contains("windows") ? ".exe" : ""; }
 
-function getQmakeFilePaths(qmakeFilePaths, qbs) {
+function getQmakeFilePaths(qmakeFilePaths, qbs, quiet) {
     if (qmakeFilePaths && qmakeFilePaths.length > 0)
         return qmakeFilePaths;
-    console.info("Detecting Qt installations...");
+    if (!quiet)
+        console.info("Detecting Qt installations...");
     var pathValue = Environment.getEnv("PATH");
     if (!pathValue)
         return [];
@@ -67,7 +68,8 @@ function getQmakeFilePaths(qmakeFilePaths, qbs) {
         if (FileInfo.completeBaseName(canonicalCandidate) !== "qtchooser")
             candidate = canonicalCandidate;
         if (!filePaths.contains(candidate)) {
-            console.info("Found Qt at '" + toNative(candidate) + "'.");
+            if (!quiet)
+                console.info("Found Qt at '" + toNative(candidate) + "'.");
             filePaths.push(candidate);
         }
     }
@@ -1608,6 +1610,33 @@ function setupOneQt(qmakeFilePath, outputBaseDir, uniquify, location, qbs) {
     return relativeSearchPaths;
 }
 
+// The generated modules only depend on what qmake reports and on the contents of the
+// lib and mkspecs directories, so a key built from these lets qbs re-use earlier output.
+function cacheKey(qmakeFilePaths, qbs) {
+    qmakeFilePaths = getQmakeFilePaths(qmakeFilePaths, qbs, true);
+    var keyData = [];
+    for (var i = 0; i < qmakeFilePaths.length; ++i) {
+        var qmakeFilePath = qmakeFilePaths[i];
+        if (!File.exists(qmakeFilePath))
+            return "";
+        try {
+            var queryResult = queryQmake(qmakeFilePath);
+        } catch (e) {
+            return ""; // Let doSetup() report the error.
+        }
+        var dirs = [pathQueryValue(queryResult, "QT_INSTALL_LIBS"),
+                    pathQueryValue(queryResult, "QMAKE_MKSPECS")
+                    || FileInfo.joinPaths(pathQueryValue(queryResult, "QT_HOST_DATA"),
+                                          "mkspecs")];
+        keyData.push(qmakeFilePath, File.lastModified(qmakeFilePath), queryResult);
+        for (var j = 0; j < dirs.length; ++j) {
+            var dirExists = dirs[j] && File.exists(dirs[j]);
+            keyData.push(dirs[j], dirExists ? File.lastModified(dirs[j]) : 0);
+        }
+    }
+    return keyData.length > 0 ? Utilities.getHash(JSON.stringify(keyData)) : "";
+}
+
 function doSetup(qmakeFilePaths, outputBaseDir, location, qbs) {
     qmakeFilePaths = getQmakeFilePaths(qmakeFilePaths, qbs);
     if (!qmakeFilePaths || qmakeFilePaths.length === 0)
@@ -28,9 +28,12 @@
 **
 ****************************************************************************/
 
+var BinaryFile = require("qbs.BinaryFile");
+var File = require("qbs.File");
 var FileInfo = require("qbs.FileInfo");
 var ModUtils = require("qbs.ModUtils");
 var PathTools = require("qbs.PathTools");
+var TextFile = require("qbs.TextFile");
 var Utilities = require("qbs.Utilities");
 
 function languageVersion(versionArray, knownValues, lang) {
@@ -357,3 +360,170 @@ function supportsArchitecture(architecture, knownArchitectures) {
     }
     return false;
 }
+
+// The module properties that must be the same for all files in a unity batch.
+// Source files for which one of them differs from the product-level value are compiled
+// separately, with these properties carried over.
+var unityBuildProperties = [
+    "commonCompilerFlags", "cxxFlags", "cxxLanguageVersion", "cxxStandardLibrary",
+    "debugInformation", "defines", "driverFlags", "enableExceptions", "enableRtti",
+    "exceptionHandlingModel", "frameworkPaths", "includePaths", "optimization",
+    "positionIndependentCode", "prefixHeaders", "systemIncludePaths", "treatWarningsAsErrors",
+    "useCxxPrecompiledHeader", "visibility", "warningLevel"
+];
+
+function unityBuildSourceSize(filePath) {
+    if (!File.exists(filePath))
+        return 0;
+    var file = new BinaryFile(filePath, BinaryFile.ReadOnly);
+    try {
+        return file.size();
+    } finally {
+        file.close();
+    }
+}
+
+// Based on the path relative to the product, so that the batches do not depend on
+// the location of the project.
+function unityBuildHash(product, filePath) {
+    return Utilities.getHash(FileInfo.relativePath(product.sourceDirectory, filePath));
+}
+
+// Batch boundaries are derived from the file paths rather than from the positions of the files
+// in the list, so that adding or removing a file only changes the batch it belongs to,
+// and the number of files per batch is rounded to a power of two, so that changes in the
+// sizes of the files rarely have an effect at all.
+function unityBuildBatches(product, sources) {
+    sources = sources.slice().sort(function(a, b) {
+        return a.filePath < b.filePath ? -1 : a.filePath > b.filePath ? 1 : 0;
+    });
+    var sizes = sources.map(function(source) { return unityBuildSourceSize(source.filePath); });
+    var totalSize = sizes.reduce(function(sum, size) { return sum + size; }, 0);
+    var averageSize = Math.max(1, totalSize / Math.max(1, sources.length));
+    var maxBatchSize = product.cpp.unityBuildBatchSize;
+    var filesPerBatch = 1;
+    while (2 * filesPerBatch * averageSize <= maxBatchSize)
+        filesPerBatch *= 2;
+    var batches = [];
+    var currentBatch = [];
+    var currentBatchSize = 0;
+    for (var i = 0; i < sources.length; ++i) {
+        currentBatch.push(sources[i]);
+        currentBatchSize += sizes[i];
+        var hash = parseInt(unityBuildHash(product, sources[i].filePath).substr(0, 8), 16);
+        if (hash % filesPerBatch === filesPerBatch - 1
+                || currentBatchSize >= 2 * maxBatchSize || i === sources.length - 1) {
+            batches.push(currentBatch);
+            currentBatch = [];
+            currentBatchSize = 0;
+        }
+    }
+    return batches;
+}
+
+function unityBuildOutputArtifacts(product, inputs) {
+    var batchableSources = [];
+    var artifacts = [];
+    (inputs["cpp.unity"] || []).forEach(function(input) {
+        var separateProperties = {};
+        var isSeparate = false;
+        unityBuildProperties.forEach(function(name) {
+            var value = input.cpp[name];
+            if (value === undefined)
+                return;
+            separateProperties[name] = value;
+            if (JSON.stringify(value) !== JSON.stringify(product.cpp[name]))
+                isSeparate = true;
+        });
+        if (!isSeparate) {
+            batchableSources.push(input);
+            return;
+        }
+        separateProperties._unityBuildSources = [input.filePath];
+        artifacts.push({
+            filePath: FileInfo.joinPaths("unity", Utilities.getHash(input.baseDir),
+                                         input.fileName),
+            fileTags: ["cpp"],
+            alwaysUpdated: false,
+            cpp: separateProperties
+        });
+    });
+    unityBuildBatches(product, batchableSources).forEach(function(batch) {
+        artifacts.push({
+            filePath: FileInfo.joinPaths("unity", "unity_" + product.targetName + "_"
+                                         + unityBuildHash(product, batch[0].filePath) + ".cpp"),
+            fileTags: ["cpp"],
+            alwaysUpdated: false,
+            cpp: { _unityBuildSources: batch.map(function(source) { return source.filePath; }) }
+        });
+    });
+    return artifacts;
+}
+
+// Only touches the file if its contents change, so that the artifacts depending on it
+// do not get rebuilt needlessly.
+function writeFileIfChanged(filePath, contents) {
+    if (File.exists(filePath)) {
+        var oldFile = new TextFile(filePath, TextFile.ReadOnly);
+        try {
+            if (oldFile.readAll() === contents)
+                return;
+        } finally {
+            oldFile.close();
+        }
+    }
+    var file = new TextFile(filePath, TextFile.WriteOnly);
+    try {
+        file.write(contents);
+    } finally {
+        file.close();
+    }
+}
+
+function writeUnityBuildFile(filePath, sources) {
+    writeFileIfChanged(filePath, sources.map(function(source) {
+        return "#include " + Utilities.cStringQuote(source) + "\n";
+    }).join(""));
+}
+
+// The system headers included by at least automaticPrecompiledHeaderThreshold percent
+// of the product's C++ sources. Unity batches are skipped, as their sources are
+// already among the inputs.
+function automaticPrecompiledHeaderIncludes(product, inputs) {
+    var sources = (inputs["cpp"] || []).filter(function(input) {
+        return !input.cpp._unityBuildSources;
+    }).concat(inputs["cpp.unity"] || []);
+    return AutoPchScanner.commonHeaders(sources,
+                                        product.cpp.automaticPrecompiledHeaderThreshold);
+}
+
+function writeAutomaticPrecompiledHeader(filePath, headers) {
+    writeFileIfChanged(filePath, headers.map(function(header) {
+        return "#include <" + header + ">\n";
+    }).join(""));
+}
+
+// The name of the module whose interface the given module unit provides, or undefined
+// if the file is neither a module interface unit nor a module partition.
+// Partitions are named "module:partition".
+function cxxModuleName(filePath) {
+    var file = new TextFile(filePath, TextFile.ReadOnly);
+    var content;
+    try {
+        content = file.readAll();
+    } finally {
+        file.close();
+    }
+    content = content.replace(/\/\*[\s\S]*?\*\//g, " ").replace(/\/\/.*$/gm, "");
+    var match = /^[ \t]*(export[ \t]+)?module[ \t]+([A-Za-z_][\w.]*)[ \t]*(:[ \t]*([A-Za-z_][\w.]*))?[^;\n]*;/m
+            .exec(content);
+    if (!match || (!match[1] && !match[4]))
+        return undefined;
+    return match[4] ? match[2] + ":" + match[4] : match[2];
+}
+
+// The dependency scanner maps module imports to the same file names.
+function compiledModuleFilePath(config, moduleName) {
+    return FileInfo.joinPaths(config.cpp._compiledModuleDirectory,
+                              moduleName.replace(/:/g, "-") + config.cpp._compiledModuleSuffix);
+}
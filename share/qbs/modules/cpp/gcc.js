@@ -599,6 +599,8 @@ function effectiveCompilerInfo(toolchain, input, output) {
             || isLegacyQnxSdk(input)) {
         if (input.qbs.toolchain.contains("qcc"))
             language = qnxLangArgs(input, tag);
+        else if (isClangModuleInterfaceUnit(input, tag))
+            language = ["-x", "c++-module"];
         else
             language = ["-x", languageName(tag) + (pchOutput ? '-header' : '')];
     }
@@ -613,6 +615,11 @@ function effectiveCompilerInfo(toolchain, input, output) {
 }
 
 
+function isClangModuleInterfaceUnit(input, tag) {
+    return tag === "cpp" && input.fileTags.contains("cppm") && input.cpp.enableCxxModules
+            && input.qbs.toolchain.contains("clang");
+}
+
 function qnxLangArgs(config, tag) {
     switch (tag) {
     case "c":
@@ -738,7 +745,8 @@ function standardFallbackValueOrDefault(toolchain, compilerVersion, languageVers
     return languageVersion;
 }
 
-function compilerFlags(project, product, input, output, explicitlyDependsOn) {
+function compilerFlags(project, product, input, output, explicitlyDependsOn,
+                       compiledModuleOutput) {
     var i;
 
     // Determine which C-language we're compiling
@@ -749,6 +757,12 @@ function compilerFlags(project, product, input, output, explicitlyDependsOn) {
     var compilerInfo = effectiveCompilerInfo(product.qbs.toolchain,
                                              input, output);
 
+    // Same command line, but the flags common to all files of a product are computed only once.
+    if (product.cpp.useNativeCompilerFlags) {
+        return Utilities.gccCompilerFlags(project, product, input, output, compilerInfo.language,
+                                          explicitlyDependsOn, compiledModuleOutput);
+    }
+
     var args = additionalCompilerAndLinkerFlags(product);
 
     Array.prototype.push.apply(args, product.cpp.sysrootFlags);
@@ -896,6 +910,8 @@ function compilerFlags(project, product, input, output, explicitlyDependsOn) {
         if (cxxStandardLibrary && product.qbs.toolchain.contains("clang")) {
             args.push("-stdlib=" + cxxStandardLibrary);
         }
+        if (input.cpp.enableCxxModules)
+            args = args.concat(cxxModuleFlags(product, input, compiledModuleOutput));
     }
 
     args.push("-o", output.filePath);
@@ -904,6 +920,17 @@ function compilerFlags(project, product, input, output, explicitlyDependsOn) {
     return args;
 }
 
+// GCC reads and writes compiled module interfaces in the gcm.cache directory below its
+// working directory, which is set up by prepareCompiler().
+function cxxModuleFlags(product, input, compiledModuleOutput) {
+    if (!product.qbs.toolchain.contains("clang"))
+        return ["-fmodules-ts"];
+    var args = ["-fprebuilt-module-path=" + input.cpp._compiledModuleDirectory];
+    if (compiledModuleOutput)
+        args.push("-fmodule-output=" + compiledModuleOutput.filePath);
+    return args;
+}
+
 function additionalCompilerAndLinkerFlags(product) {
     var args = []
 
@@ -1005,12 +1032,18 @@ function setResponseFileThreshold(command, product)
 }
 
 function prepareCompiler(project, product, inputs, outputs, input, output, explicitlyDependsOn) {
+    // Module interface units have their compiled interface as a second output.
+    var compiledModuleOutput = outputs.cpp_bmi ? outputs.cpp_bmi[0] : undefined;
+    if (compiledModuleOutput)
+        output = (outputs.obj || outputs.intermediate_obj)[0];
+
     var compilerInfo = effectiveCompilerInfo(product.qbs.toolchain,
                                              input, output);
     var compilerPath = compilerInfo.path;
     var pchOutput = output.fileTags.contains(compilerInfo.tag + "_pch");
 
-    var args = compilerFlags(project, product, input, output, explicitlyDependsOn);
+    var args = compilerFlags(project, product, input, output, explicitlyDependsOn,
+                             compiledModuleOutput);
     var wrapperArgsLength = 0;
     var wrapperArgs = product.cpp.compilerWrapper;
     var extraEnv;
@@ -1049,6 +1082,10 @@ function prepareCompiler(project, product, inputs, outputs, input, output, expli
         cmd.environment = extraEnv;
     cmd.responseFileArgumentIndex = wrapperArgsLength;
     cmd.responseFileUsagePrefix = '@';
+    if (compilerInfo.tag === "cpp" && input.cpp.enableCxxModules
+            && !product.qbs.toolchain.contains("clang")) {
+        cmd.workingDirectory = FileInfo.path(input.cpp._compiledModuleDirectory);
+    }
     setResponseFileThreshold(cmd, product);
     return cmd;
 }
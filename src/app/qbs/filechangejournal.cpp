@@ -0,0 +1,108 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qbs.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "filechangejournal.h"
+
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qfilesystemwatcher.h>
+
+namespace qbs {
+namespace Internal {
+
+FileChangeJournal::FileChangeJournal(QObject *parent)
+    : QObject(parent), m_watcher(new QFileSystemWatcher(this))
+{
+    connect(m_watcher, &QFileSystemWatcher::fileChanged,
+            this, &FileChangeJournal::handleFileChanged);
+}
+
+bool FileChangeJournal::setWatchedFiles(const QStringList &filePaths)
+{
+    const QSet<QString> newFilePaths(filePaths.cbegin(), filePaths.cend());
+    const QStringList oldFilePathsList = m_watcher->files();
+    const QSet<QString> oldFilePaths(oldFilePathsList.cbegin(), oldFilePathsList.cend());
+    const QSet<QString> obsoleteFilePaths = QSet<QString>(oldFilePaths).subtract(newFilePaths);
+    const QSet<QString> addedFilePaths = QSet<QString>(newFilePaths).subtract(oldFilePaths);
+    if (!obsoleteFilePaths.isEmpty())
+        m_watcher->removePaths(obsoleteFilePaths.values());
+    if (addedFilePaths.isEmpty() || m_watcher->addPaths(addedFilePaths.values()).isEmpty())
+        return true;
+
+    // The system refuses to watch some of the files (e.g. because the inotify limit
+    // was hit), so we cannot know about changes to them. Give up completely.
+    const QStringList watchedFiles = m_watcher->files();
+    if (!watchedFiles.isEmpty())
+        m_watcher->removePaths(watchedFiles);
+    m_changedFiles.clear();
+    m_isValid = false;
+    return false;
+}
+
+void FileChangeJournal::setValid(bool valid)
+{
+    m_isValid = valid && !m_watcher->files().isEmpty();
+}
+
+QStringList FileChangeJournal::takeChangedFiles()
+{
+    const QStringList changedFiles = m_changedFiles.values();
+    m_changedFiles.clear();
+    return changedFiles;
+}
+
+void FileChangeJournal::removeChangedFiles(const QStringList &filePaths)
+{
+    for (const QString &filePath : filePaths)
+        m_changedFiles.remove(filePath);
+}
+
+void FileChangeJournal::handleFileChanged(const QString &filePath)
+{
+    m_changedFiles << filePath;
+
+    // Editors often save files by writing a new file and renaming it over the old one,
+    // which makes the watcher forget about the path.
+    if (!m_watcher->files().contains(filePath) && QFileInfo::exists(filePath)
+            && !m_watcher->addPath(filePath)) {
+        m_isValid = false;
+    }
+}
+
+} // namespace Internal
+} // namespace qbs
@@ -0,0 +1,84 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qbs.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QBS_FILECHANGEJOURNAL_H
+#define QBS_FILECHANGEJOURNAL_H
+
+#include <QtCore/qobject.h>
+#include <QtCore/qset.h>
+#include <QtCore/qstringlist.h>
+
+QT_BEGIN_NAMESPACE
+class QFileSystemWatcher;
+QT_END_NAMESPACE
+
+namespace qbs {
+namespace Internal {
+
+// Records which of a set of watched files have changed between two builds.
+// The journal is only trustworthy if it has been watching all relevant files without
+// interruption since the last complete build; otherwise, isValid() returns false and
+// the caller must fall back to checking all files.
+class FileChangeJournal : public QObject
+{
+    Q_OBJECT
+public:
+    explicit FileChangeJournal(QObject *parent = nullptr);
+
+    bool setWatchedFiles(const QStringList &filePaths);
+
+    bool isValid() const { return m_isValid; }
+    void setValid(bool valid);
+
+    QStringList changedFiles() const { return m_changedFiles.values(); }
+    QStringList takeChangedFiles();
+    void removeChangedFiles(const QStringList &filePaths);
+
+private:
+    void handleFileChanged(const QString &filePath);
+
+    QFileSystemWatcher * const m_watcher;
+    QSet<QString> m_changedFiles;
+    bool m_isValid = false;
+};
+
+} // namespace Internal
+} // namespace qbs
+
+#endif // Include guard
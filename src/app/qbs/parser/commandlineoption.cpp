@@ -355,6 +355,33 @@ QString ChangedFilesOption::longRepresentation() const
     return QStringLiteral("--changed-files");
 }
 
+QString FilesToConsiderOption::description(CommandType command) const
+{
+    Q_UNUSED(command);
+    return Tr::tr("%1 <file>[,<file>...]\n"
+                  "\tBuild only the artifacts that are derived from these files.\n"
+                  "\tUsually combined with %2.\n")
+            .arg(longRepresentation(), ActiveFileTagsOption().longRepresentation());
+}
+
+QString FilesToConsiderOption::longRepresentation() const
+{
+    return QStringLiteral("--files-to-consider");
+}
+
+QString ActiveFileTagsOption::description(CommandType command) const
+{
+    Q_UNUSED(command);
+    return Tr::tr("%1 <tag>[,<tag>...]\n"
+                  "\tBuild only artifacts that have one of these file tags.\n")
+            .arg(longRepresentation());
+}
+
+QString ActiveFileTagsOption::longRepresentation() const
+{
+    return QStringLiteral("--active-file-tags");
+}
+
 QString ProductsOption::description(CommandType command) const
 {
     const QString prefix = Tr::tr("%1|%2").arg(longRepresentation(), shortRepresentation());
@@ -623,6 +650,30 @@ QString RespectProjectJobLimitsOption::longRepresentation() const
     return QStringLiteral("--enforce-project-job-limits");
 }
 
+QString MakeJobServerOption::description(CommandType command) const
+{
+    Q_UNUSED(command);
+    return Tr::tr("%1\n\tMake the job tokens available to sub-processes via the "
+                  "GNU make jobserver protocol.\n").arg(longRepresentation());
+}
+
+QString MakeJobServerOption::longRepresentation() const
+{
+    return QStringLiteral("--make-jobserver");
+}
+
+QString AdaptiveJobSchedulingOption::description(CommandType command) const
+{
+    Q_UNUSED(command);
+    return Tr::tr("%1\n\tHold back memory-intensive jobs while the system is low on memory "
+                  "or overloaded.\n").arg(longRepresentation());
+}
+
+QString AdaptiveJobSchedulingOption::longRepresentation() const
+{
+    return QStringLiteral("--adaptive-job-scheduling");
+}
+
 CommandEchoModeOption::CommandEchoModeOption() = default;
 
 QString CommandEchoModeOption::description(CommandType command) const
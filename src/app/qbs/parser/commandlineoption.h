@@ -61,6 +61,8 @@ public:
         ForceProbesOptionType,
         ShowProgressOptionType,
         ChangedFilesOptionType,
+        FilesToConsiderOptionType,
+        ActiveFileTagsOptionType,
         ProductsOptionType,
         NoInstallOptionType,
         InstallRootOptionType, RemoveFirstOptionType, NoBuildOptionType,
@@ -72,6 +74,8 @@ public:
         SettingsDirOptionType,
         JobLimitsOptionType,
         RespectProjectJobLimitsOptionType,
+        MakeJobServerOptionType,
+        AdaptiveJobSchedulingOptionType,
         GeneratorOptionType,
         WaitLockOptionType,
         RunEnvConfigOptionType,
@@ -278,6 +282,20 @@ class ChangedFilesOption : public StringListOption
     QString longRepresentation() const override;
 };
 
+class FilesToConsiderOption : public StringListOption
+{
+    QString description(CommandType command) const override;
+    QString shortRepresentation() const override { return {}; }
+    QString longRepresentation() const override;
+};
+
+class ActiveFileTagsOption : public StringListOption
+{
+    QString description(CommandType command) const override;
+    QString shortRepresentation() const override { return {}; }
+    QString longRepresentation() const override;
+};
+
 class ProductsOption : public StringListOption
 {
 public:
@@ -407,6 +425,22 @@ public:
     QString longRepresentation() const override;
 };
 
+class MakeJobServerOption : public OnOffOption
+{
+public:
+    QString description(CommandType command) const override;
+    QString shortRepresentation() const override { return {}; }
+    QString longRepresentation() const override;
+};
+
+class AdaptiveJobSchedulingOption : public OnOffOption
+{
+public:
+    QString description(CommandType command) const override;
+    QString shortRepresentation() const override { return {}; }
+    QString longRepresentation() const override;
+};
+
 class WaitLockOption : public OnOffOption
 {
 public:
@@ -83,6 +83,12 @@ CommandLineOption *CommandLineOptionPool::getOption(CommandLineOption::Type type
         case CommandLineOption::ChangedFilesOptionType:
             option = new ChangedFilesOption;
             break;
+        case CommandLineOption::FilesToConsiderOptionType:
+            option = new FilesToConsiderOption;
+            break;
+        case CommandLineOption::ActiveFileTagsOptionType:
+            option = new ActiveFileTagsOption;
+            break;
         case CommandLineOption::ProductsOptionType:
             option = new ProductsOption;
             break;
@@ -122,6 +128,12 @@ CommandLineOption *CommandLineOptionPool::getOption(CommandLineOption::Type type
         case CommandLineOption::RespectProjectJobLimitsOptionType:
             option = new RespectProjectJobLimitsOption;
             break;
+        case CommandLineOption::MakeJobServerOptionType:
+            option = new MakeJobServerOption;
+            break;
+        case CommandLineOption::AdaptiveJobSchedulingOptionType:
+            option = new AdaptiveJobSchedulingOption;
+            break;
         case CommandLineOption::GeneratorOptionType:
             option = new GeneratorOption;
             break;
@@ -186,6 +198,18 @@ ChangedFilesOption *CommandLineOptionPool::changedFilesOption() const
     return static_cast<ChangedFilesOption *>(getOption(CommandLineOption::ChangedFilesOptionType));
 }
 
+FilesToConsiderOption *CommandLineOptionPool::filesToConsiderOption() const
+{
+    return static_cast<FilesToConsiderOption *>(
+                getOption(CommandLineOption::FilesToConsiderOptionType));
+}
+
+ActiveFileTagsOption *CommandLineOptionPool::activeFileTagsOption() const
+{
+    return static_cast<ActiveFileTagsOption *>(
+                getOption(CommandLineOption::ActiveFileTagsOptionType));
+}
+
 KeepGoingOption *CommandLineOptionPool::keepGoingOption() const
 {
     return static_cast<KeepGoingOption *>(getOption(CommandLineOption::KeepGoingOptionType));
@@ -266,6 +290,18 @@ RespectProjectJobLimitsOption *CommandLineOptionPool::respectProjectJobLimitsOpt
                 getOption(CommandLineOption::RespectProjectJobLimitsOptionType));
 }
 
+MakeJobServerOption *CommandLineOptionPool::makeJobServerOption() const
+{
+    return static_cast<MakeJobServerOption *>(
+                getOption(CommandLineOption::MakeJobServerOptionType));
+}
+
+AdaptiveJobSchedulingOption *CommandLineOptionPool::adaptiveJobSchedulingOption() const
+{
+    return static_cast<AdaptiveJobSchedulingOption *>(
+                getOption(CommandLineOption::AdaptiveJobSchedulingOptionType));
+}
+
 GeneratorOption *CommandLineOptionPool::generatorOption() const
 {
     return static_cast<GeneratorOption *>(getOption(CommandLineOption::GeneratorOptionType));
@@ -60,6 +60,8 @@ public:
     DryRunOption *dryRunOption() const;
     ForceProbesOption *forceProbesOption() const;
     ChangedFilesOption *changedFilesOption() const;
+    FilesToConsiderOption *filesToConsiderOption() const;
+    ActiveFileTagsOption *activeFileTagsOption() const;
     KeepGoingOption *keepGoingOption() const;
     JobsOption *jobsOption() const;
     ProductsOption *productsOption() const;
@@ -75,6 +77,8 @@ public:
     SettingsDirOption *settingsDirOption() const;
     JobLimitsOption *jobLimitsOption() const;
     RespectProjectJobLimitsOption *respectProjectJobLimitsOption() const;
+    MakeJobServerOption *makeJobServerOption() const;
+    AdaptiveJobSchedulingOption *adaptiveJobSchedulingOption() const;
     GeneratorOption *generatorOption() const;
     WaitLockOption *waitLockOption() const;
     DisableFallbackProviderOption *disableFallbackProviderOption() const;
@@ -452,6 +452,11 @@ void CommandLineParser::CommandLineParserPrivate::setupBuildOptions()
     for (QString &file : changedFiles)
         file = QDir::fromNativeSeparators(currentDir.absoluteFilePath(file));
     buildOptions.setChangedFiles(changedFiles);
+    QStringList filesToConsider = optionPool.filesToConsiderOption()->arguments();
+    for (QString &file : filesToConsider)
+        file = QDir::fromNativeSeparators(currentDir.absoluteFilePath(file));
+    buildOptions.setFilesToConsider(filesToConsider);
+    buildOptions.setActiveFileTags(optionPool.activeFileTagsOption()->arguments());
     buildOptions.setKeepGoing(optionPool.keepGoingOption()->enabled());
     buildOptions.setForceTimestampCheck(optionPool.forceTimestampCheckOption()->enabled());
     buildOptions.setForceOutputCheck(optionPool.forceOutputCheckOption()->enabled());
@@ -464,6 +469,9 @@ void CommandLineParser::CommandLineParserPrivate::setupBuildOptions()
     buildOptions.setJobLimits(optionPool.jobLimitsOption()->jobLimits());
     buildOptions.setProjectJobLimitsTakePrecedence(
                 optionPool.respectProjectJobLimitsOption()->enabled());
+    buildOptions.setProvideMakeJobServer(optionPool.makeJobServerOption()->enabled());
+    buildOptions.setAdaptiveJobScheduling(
+                optionPool.adaptiveJobSchedulingOption()->enabled());
     buildOptions.setSettingsDirectory(settingsDir());
 }
 
@@ -275,6 +275,8 @@ static QList<CommandLineOption::Type> buildOptions()
     return options << CommandLineOption::KeepGoingOptionType
             << CommandLineOption::ProductsOptionType
             << CommandLineOption::ChangedFilesOptionType
+            << CommandLineOption::FilesToConsiderOptionType
+            << CommandLineOption::ActiveFileTagsOptionType
             << CommandLineOption::ForceTimestampCheckOptionType
             << CommandLineOption::ForceOutputCheckOptionType
             << CommandLineOption::BuildNonDefaultOptionType
@@ -284,6 +286,8 @@ static QList<CommandLineOption::Type> buildOptions()
             << CommandLineOption::RemoveFirstOptionType
             << CommandLineOption::JobLimitsOptionType
             << CommandLineOption::RespectProjectJobLimitsOptionType
+            << CommandLineOption::MakeJobServerOptionType
+            << CommandLineOption::AdaptiveJobSchedulingOptionType
             << CommandLineOption::WaitLockOptionType;
 }
 
@@ -5,6 +5,7 @@ TARGET = qbs
 
 SOURCES += main.cpp \
     ctrlchandler.cpp \
+    filechangejournal.cpp \
     application.cpp \
     session.cpp \
     sessionpacket.cpp \
@@ -17,6 +18,7 @@ SOURCES += main.cpp \
 
 HEADERS += \
     ctrlchandler.h \
+    filechangejournal.h \
     application.h \
     session.h \
     sessionpacket.h \
@@ -46,7 +48,7 @@ CONFIG(static, static|shared) {
         include(../../plugins/scanner/$$scannerPlugin/$${scannerPlugin}.pri) \
         include(../../plugins/use_plugin.pri)
     }
-    generatorPlugins = clangcompilationdb iarew keiluv makefilegenerator visualstudio
+    generatorPlugins = clangcompilationdb iarew keiluv makefilegenerator ninjagenerator visualstudio
     for (generatorPlugin, generatorPlugins) {
         include(../../plugins/generator/$$generatorPlugin/$${generatorPlugin}.pri) \
         include(../../plugins/use_plugin.pri)
@@ -39,6 +39,7 @@
 
 #include "session.h"
 
+#include "filechangejournal.h"
 #include "sessionpacket.h"
 #include "sessionpacketreader.h"
 
@@ -61,10 +62,12 @@
 
 #include <QtCore/qcoreapplication.h>
 #include <QtCore/qdir.h>
+#include <QtCore/qhash.h>
 #include <QtCore/qjsonarray.h>
 #include <QtCore/qjsonobject.h>
 #include <QtCore/qobject.h>
 #include <QtCore/qprocess.h>
+#include <QtCore/qset.h>
 
 #include <algorithm>
 #include <cstdlib>
@@ -125,6 +128,8 @@ private:
             );
     void setLogLevelFromRequest(const QJsonObject &request);
     bool checkNormalRequestPrerequisites(const char *replyType);
+    void updateFileChangeJournal();
+    void watchProjectFiles();
 
     void sendPacket(const QJsonObject &message);
     void setupProject(const QJsonObject &request);
@@ -173,6 +178,8 @@ private:
     QJsonObject m_resolveRequest;
     QStringList m_moduleProperties;
     AbstractJob *m_currentJob = nullptr;
+    FileChangeJournal *m_fileChangeJournal = nullptr;
+    bool m_watchFiles = false;
 };
 
 void startSession()
@@ -270,6 +277,7 @@ void Session::setupProject(const QJsonObject &request)
                                                 "/" QBS_RELATIVE_PLUGINS_PATH)));
     params.setLibexecPath(appDir + QLatin1String("/" QBS_RELATIVE_LIBEXEC_PATH));
     params.setOverrideBuildGraphData(true);
+    m_watchFiles = request.value(QLatin1String("watch-files")).toBool();
     setLogLevelFromRequest(request);
     SetupProjectJob * const setupJob = m_project.setupProject(params, &m_logSink, this);
     m_currentJob = setupJob;
@@ -287,6 +295,7 @@ void Session::setupProject(const QJsonObject &request)
         const ProjectData oldProjectData = m_projectData;
         m_project = setupJob->project();
         m_projectData = m_project.projectData();
+        updateFileChangeJournal();
         QJsonObject reply;
         reply.insert(StringConstants::type(), QLatin1String("project-resolved"));
         if (success)
@@ -299,6 +308,59 @@ void Session::setupProject(const QJsonObject &request)
     });
 }
 
+static bool allProductsAreBuiltByDefault(const ProjectData &projectData)
+{
+    const QList<ProductData> products = projectData.allProducts();
+    return std::all_of(products.cbegin(), products.cend(), [](const ProductData &product) {
+        return !product.isEnabled() || product.properties().value(
+                    StringConstants::builtByDefaultProperty(), true).toBool();
+    });
+}
+
+// The files that a build of the given products has looked at. Files that also belong to
+// products outside of the build are excluded, as these products have not seen the changes.
+static QSet<QString> sourceFilesOfBuiltProducts(const ProjectData &projectData,
+                                              const QList<ProductData> &selectedProducts,
+                                              bool includeNonDefault)
+{
+    const QList<ProductData> allProducts = projectData.allProducts();
+    QSet<QString> builtProducts;
+    QStringList productsToAdd;
+    if (selectedProducts.empty()) {
+        for (const ProductData &product : allProducts) {
+            if (product.isEnabled() && (includeNonDefault || product.properties().value(
+                    StringConstants::builtByDefaultProperty(), true).toBool())) {
+                productsToAdd << product.fullDisplayName();
+            }
+        }
+    } else {
+        for (const ProductData &product : selectedProducts)
+            productsToAdd << product.fullDisplayName();
+    }
+    QHash<QString, ProductData> productsByName;
+    for (const ProductData &product : allProducts)
+        productsByName.insert(product.fullDisplayName(), product);
+    while (!productsToAdd.isEmpty()) {
+        const QString name = productsToAdd.takeLast();
+        if (builtProducts.contains(name))
+            continue;
+        builtProducts << name;
+        productsToAdd << productsByName.value(name).dependencies();
+    }
+
+    QSet<QString> builtFiles;
+    QSet<QString> otherFiles;
+    for (const ProductData &product : allProducts) {
+        QSet<QString> &files = builtProducts.contains(product.fullDisplayName())
+                ? builtFiles : otherFiles;
+        for (const GroupData &group : product.groups()) {
+            for (const QString &filePath : group.allFilePaths())
+                files << filePath;
+        }
+    }
+    return builtFiles.subtract(otherFiles);
+}
+
 void Session::buildProject(const QJsonObject &request)
 {
     if (!checkNormalRequestPrerequisites("project-built"))
@@ -307,6 +369,40 @@ void Session::buildProject(const QJsonObject &request)
     setLogLevelFromRequest(request);
     auto options = BuildOptions::fromJson(request);
     options.setSettingsDirectory(m_settings->baseDirectory());
+
+    // The executor only looks at the files of the products it builds. A partial build
+    // therefore must not consume the journal, or the changes to the other products get lost.
+    // Passing the full list is still correct, as it contains all changes since the last
+    // full build. Once a partial build of complete products has succeeded, the changes to
+    // their files are known to the build graph and get removed from the journal; otherwise,
+    // the next build would consider them changed once more.
+    const bool isFullBuild = productSelection.products.empty()
+            && options.filesToConsider().isEmpty() && options.activeFileTags().isEmpty()
+            && (productSelection.selection == Project::ProductSelectionWithNonDefault
+                || allProductsAreBuiltByDefault(m_projectData));
+    QStringList journalFilesToRemove;
+    // If the client provides its own list of changed files, the journal is left alone,
+    // as the build does not get to see the changes it has recorded.
+    if (m_fileChangeJournal && !request.contains(QLatin1String("changed-files"))) {
+        if (m_fileChangeJournal->isValid()) {
+            options.setChangedFiles(isFullBuild ? m_fileChangeJournal->takeChangedFiles()
+                                                : m_fileChangeJournal->changedFiles());
+            options.setChangedFilesComplete(true);
+            if (!isFullBuild && options.filesToConsider().isEmpty()
+                    && options.activeFileTags().isEmpty()) {
+                const QSet<QString> builtFiles = sourceFilesOfBuiltProducts(m_projectData,
+                        productSelection.products,
+                        productSelection.selection == Project::ProductSelectionWithNonDefault);
+                for (const QString &filePath : options.changedFiles()) {
+                    if (builtFiles.contains(filePath))
+                        journalFilesToRemove << filePath;
+                }
+            }
+        } else if (isFullBuild) {
+            // All timestamps get checked, so the recorded changes are of no use anymore.
+            m_fileChangeJournal->takeChangedFiles();
+        }
+    }
     BuildJob * const buildJob = productSelection.products.empty()
             ? m_project.buildAllProducts(options, productSelection.selection, this)
             : m_project.buildSomeProducts(productSelection.products, options, this);
@@ -330,11 +426,23 @@ void Session::buildProject(const QJsonObject &request)
         sendPacket(resultData);
     });
     connect(buildJob, &BuildJob::finished, this,
-            [this, dataMode](bool success) {
+            [this, dataMode, isFullBuild, journalFilesToRemove](bool success) {
         QJsonObject reply;
         reply.insert(StringConstants::type(), QLatin1String("project-built"));
         const ProjectData oldProjectData = m_projectData;
         m_projectData = m_project.projectData();
+        if (m_fileChangeJournal) {
+            // Only a successful build is guaranteed to have seen the current state of
+            // all source files. It might also have found new file dependencies.
+            // A partial build has only seen some of the changes, so it cannot make the
+            // journal valid.
+            if (success)
+                watchProjectFiles();
+            if (isFullBuild)
+                m_fileChangeJournal->setValid(success);
+            else if (success)
+                m_fileChangeJournal->removeChangedFiles(journalFilesToRemove);
+        }
         if (success)
             insertProjectDataIfNecessary(reply, dataMode, oldProjectData, false);
         else
@@ -607,6 +715,7 @@ void Session::releaseProject()
     m_project = Project();
     m_projectData = ProjectData();
     m_resolveRequest = QJsonObject();
+    updateFileChangeJournal();
     QJsonObject reply;
     reply.insert(StringConstants::type(), QLatin1String(replyType));
     sendPacket(reply);
@@ -712,6 +821,38 @@ bool Session::checkNormalRequestPrerequisites(const char *replyType)
     return true;
 }
 
+void Session::updateFileChangeJournal()
+{
+    if (!m_watchFiles || !m_project.isValid()) {
+        delete m_fileChangeJournal;
+        m_fileChangeJournal = nullptr;
+        return;
+    }
+    if (!m_fileChangeJournal)
+        m_fileChangeJournal = new FileChangeJournal(this);
+
+    // The source files might have changed between the last build and now, so the journal
+    // becomes valid only after the next build.
+    m_fileChangeJournal->setValid(false);
+    watchProjectFiles();
+}
+
+void Session::watchProjectFiles()
+{
+    QStringList filePaths;
+    for (const ProductData &product : m_projectData.allProducts()) {
+        for (const GroupData &group : product.groups())
+            filePaths << group.allFilePaths();
+    }
+    for (const QString &filePath : m_project.fileDependencies())
+        filePaths << filePath;
+    if (!m_fileChangeJournal->setWatchedFiles(filePaths)) {
+        m_logSink.printWarning(ErrorInfo(tr("Not all source files can be watched for changes. "
+                                            "Falling back to checking all timestamps on every "
+                                            "build.")));
+    }
+}
+
 QStringList Session::modulePropertiesFromRequest(const QJsonObject &request)
 {
     return fromJson<QStringList>(request.value(StringConstants::modulePropertiesKey()));
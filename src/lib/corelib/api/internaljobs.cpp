@@ -61,7 +61,7 @@
 
 #include <QtCore/qtimer.h>
 
-#include <mutex>
+#include <atomic>
 
 namespace qbs {
 namespace Internal {
@@ -72,11 +72,7 @@ public:
     JobObserver(InternalJob *job) : m_job(job) { }
     ~JobObserver() override { delete m_timedLogger; }
 
-    void cancel()
-    {
-        std::lock_guard<std::mutex> lock(m_cancelMutex);
-        m_canceled = true;
-    }
+    void cancel() { m_canceled = true; }
 
 private:
     void initialize(const QString &task, int maximum) override
@@ -85,6 +81,7 @@ private:
         if (m_job->timed())
             m_timedLogger = new TimedActivityLogger(m_job->logger(), task, true);
         m_value = 0;
+        m_reportedPermille = 0;
         m_maximum = maximum;
         emit m_job->newTaskStarted(task, maximum, m_job);
     }
@@ -104,21 +101,25 @@ private:
             delete m_timedLogger;
             m_timedLogger = nullptr;
         }
+
+        // Progress is typically reported from a different thread than the one the client
+        // lives in, and there can be a great many small steps. So we only send an update
+        // if it is visible at a resolution of one per mille, or if the task is done.
+        const int permille = m_maximum > 0 ? int(qint64(value) * 1000 / m_maximum) : 0;
+        if (permille == m_reportedPermille && value < m_maximum)
+            return;
+        m_reportedPermille = permille;
         emit m_job->taskProgress(value, m_job);
     }
 
     int progressValue() override { return m_value; }
     int maximum() const override { return m_maximum; }
-    bool canceled() const override
-    {
-        std::lock_guard<std::mutex> lock(m_cancelMutex);
-        return m_canceled;
-    }
+    bool canceled() const override { return m_canceled; }
 
     int m_value = 0;
+    int m_reportedPermille = 0;
     int m_maximum = 0;
-    mutable std::mutex m_cancelMutex;
-    bool m_canceled = false;
+    std::atomic_bool m_canceled{false};
     InternalJob * const m_job;
     TimedActivityLogger *m_timedLogger = nullptr;
 };
@@ -394,12 +395,25 @@ void InternalBuildJob::build(const TopLevelProjectPtr &project,
     executorThread->start();
 }
 
+void InternalBuildJob::cancel()
+{
+    InternalJob::cancel();
+
+    // Let the executor react right away, rather than waiting for the next job to finish.
+    if (m_executor) {
+        Executor * const executor = m_executor;
+        QMetaObject::invokeMethod(executor, [executor] { executor->checkForCancellation(); },
+                                  Qt::QueuedConnection);
+    }
+}
+
 void InternalBuildJob::handleFinished()
 {
     setError(m_executor->error());
     project()->buildData->evaluationContext.reset();
     storeBuildGraph();
     m_executor->deleteLater();
+    m_executor = nullptr;
 }
 
 void InternalBuildJob::emitFinished()
@@ -70,7 +70,7 @@ class InternalJob : public QObject
 public:
     ~InternalJob() override;
 
-    void cancel();
+    virtual void cancel();
     virtual void start() {}
     ErrorInfo error() const { return m_error; }
     void setError(const ErrorInfo &error) { m_error = error; }
@@ -181,6 +181,7 @@ public:
 
     void build(const TopLevelProjectPtr &project, const QVector<ResolvedProductPtr> &products,
                const BuildOptions &buildOptions);
+    void cancel() override;
 
 private:
     void handleFinished();
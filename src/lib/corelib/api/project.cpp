@@ -54,6 +54,7 @@
 #include <buildgraph/buildgraph.h>
 #include <buildgraph/buildgraphloader.h>
 #include <buildgraph/emptydirectoriesremover.h>
+#include <buildgraph/filedependency.h>
 #include <buildgraph/nodetreedumper.h>
 #include <buildgraph/productbuilddata.h>
 #include <buildgraph/productinstaller.h>
@@ -611,10 +612,13 @@ ProjectTransformerData ProjectPrivate::transformerData()
         for (const Transformer * const t : allTransformers) {
             TransformerData tData;
             Set<const Artifact *> allInputs;
+            Set<QString> fileDependencies;
             for (Artifact * const a : t->outputs) {
                 tData.d->outputs << createArtifactData(a, product, targetArtifacts);
                 for (const Artifact * const child : filterByType<Artifact>(a->children))
                     allInputs << child;
+                for (const FileDependency * const dep : qAsConst(a->fileDependencies))
+                    fileDependencies << dep->filePath();
                 for (Artifact * const a
                      : RulesApplicator::collectAuxiliaryInputs(t->rule.get(), product.get())) {
                     if (a->artifactType == Artifact::Generated)
@@ -624,6 +628,7 @@ ProjectTransformerData ProjectPrivate::transformerData()
             for (const Artifact * const input : allInputs)
                 tData.d->inputs << createArtifactData(input, product, targetArtifacts);
             tData.d->commands = ruleCommandListForTransformer(t);
+            tData.d->fileDependencies = fileDependencies.toStringList();
             productTransformerData << tData;
         }
         projectTransformerData << qMakePair(productData, productTransformerData);
@@ -966,6 +971,22 @@ std::set<QString> Project::buildSystemFiles() const
     return d->internalProject->buildSystemFiles.toStdSet();
 }
 
+/*!
+ * \brief The files outside of the project's products that build artifacts are known to depend on.
+ * These are typically headers found by dependency scanners. The list is only complete
+ * after the project has been built.
+ */
+std::set<QString> Project::fileDependencies() const
+{
+    QBS_ASSERT(isValid(), return {});
+    std::set<QString> filePaths;
+    if (!d->internalProject->buildData)
+        return filePaths;
+    for (const FileDependency * const dep : d->internalProject->buildData->fileDependencies)
+        filePaths.insert(dep->filePath());
+    return filePaths;
+}
+
 RuleCommandList Project::ruleCommands(const ProductData &product,
         const QString &inputFilePath, const QString &outputFileTag, ErrorInfo *error) const
 {
@@ -135,6 +135,7 @@ public:
     QVariantMap projectConfiguration() const;
 
     std::set<QString> buildSystemFiles() const;
+    std::set<QString> fileDependencies() const;
 
     RuleCommandList ruleCommands(const ProductData &product, const QString &inputFilePath,
                                  const QString &outputFileTag, ErrorInfo *error = nullptr) const;
@@ -52,5 +52,6 @@ TransformerData& TransformerData::operator=(const TransformerData &other) = defa
 QList<ArtifactData> TransformerData::inputs() const { return d->inputs; }
 QList<ArtifactData> TransformerData::outputs() const { return d->outputs; }
 RuleCommandList TransformerData::commands() const { return d->commands; }
+QStringList TransformerData::fileDependencies() const { return d->fileDependencies; }
 
 } // namespace qbs
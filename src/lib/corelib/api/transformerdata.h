@@ -65,6 +65,7 @@ public:
     QList<ArtifactData> inputs() const;
     QList<ArtifactData> outputs() const;
     RuleCommandList commands() const;
+    QStringList fileDependencies() const;
 
 private:
     QExplicitlySharedDataPointer<Internal::TransformerDataPrivate> d;
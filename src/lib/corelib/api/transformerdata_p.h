@@ -51,6 +51,7 @@ public:
     QList<ArtifactData> inputs;
     QList<ArtifactData> outputs;
     RuleCommandList commands;
+    QStringList fileDependencies;
 };
 
 } // namespace Internal
@@ -76,6 +76,7 @@ static void invalidateArtifactTimestamp(Artifact *artifact)
 {
     if (artifact->timestamp().isValid()) {
         artifact->clearTimestamp();
+        artifact->product->buildData->invalidateUpToDateState();
         artifact->product->topLevelProject()->buildData->setDirty();
     }
 }
@@ -113,6 +114,10 @@ public:
     void visitProduct(const ResolvedProductPtr &product)
     {
         m_product = product;
+        if (!m_options.dryRun() && product->buildData->upToDateState().valid) {
+            product->buildData->invalidateUpToDateState();
+            product->topLevelProject()->buildData->setDirty();
+        }
         ArtifactVisitor::visitProduct(product);
         const AllRescuableArtifactData rescuableArtifactData
                 = product->buildData->rescuableArtifactData();
@@ -0,0 +1,147 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qbs.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "autopchscanner.h"
+
+#include "artifact.h"
+#include "depscanner.h"
+#include "rawscanresults.h"
+#include <language/language.h>
+#include <language/scriptengine.h>
+#include <logging/categories.h>
+#include <logging/translator.h>
+#include <tools/scannerpluginmanager.h>
+#include <tools/scripttools.h>
+#include <tools/set.h>
+#include <tools/stringconstants.h>
+
+#include <QtCore/qhash.h>
+
+#include <QtScript/qscriptcontext.h>
+#include <QtScript/qscriptengine.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace qbs {
+namespace Internal {
+
+static QString autoPchScannerJsName() { return QStringLiteral("AutoPchScanner"); }
+
+AutoPchScanner::AutoPchScanner(const ResolvedProductPtr &product, QScriptValue targetScriptValue)
+    : m_product(product)
+    , m_targetScriptValue(targetScriptValue)
+{
+    const auto engine = static_cast<ScriptEngine *>(targetScriptValue.engine());
+    QScriptValue scannerObj = engine->newObject();
+    targetScriptValue.setProperty(autoPchScannerJsName(), scannerObj);
+    QScriptValue commonHeadersFunction = engine->newFunction(&js_commonHeaders, this);
+    scannerObj.setProperty(QStringLiteral("commonHeaders"), commonHeadersFunction);
+}
+
+AutoPchScanner::~AutoPchScanner()
+{
+    m_targetScriptValue.setProperty(autoPchScannerJsName(), QScriptValue());
+}
+
+QScriptValue AutoPchScanner::js_commonHeaders(QScriptContext *ctx, QScriptEngine *engine,
+                                              AutoPchScanner *that)
+{
+    if (Q_UNLIKELY(ctx->argumentCount() != 2)) {
+        return ctx->throwError(QScriptContext::SyntaxError,
+                               Tr::tr("commonHeaders expects 2 arguments"));
+    }
+    return that->commonHeaders(engine, ctx->argument(0), ctx->argument(1).toInt32());
+}
+
+QScriptValue AutoPchScanner::commonHeaders(QScriptEngine *engine, const QScriptValue &inputs,
+                                           int thresholdPercent)
+{
+    if (!m_cppScanner) {
+        const auto scanners = ScannerPluginManager::scannersForFileTag("cpp");
+        if (scanners.size() != 1) {
+            return engine->currentContext()->throwError(
+                        Tr::tr("There are %1 scanners for the file tag %2. "
+                               "Expected is exactly one.").arg(scanners.size())
+                        .arg(QStringLiteral("cpp")));
+        }
+        m_cppScanner = scanners.front();
+    }
+
+    std::vector<const Artifact *> artifacts;
+    const quint32 inputCount = inputs.property(StringConstants::lengthProperty()).toUInt32();
+    for (quint32 i = 0; i < inputCount; ++i) {
+        if (const auto artifact = attachedPointer<Artifact>(inputs.property(i)))
+            artifacts.push_back(artifact);
+    }
+    std::sort(artifacts.begin(), artifacts.end(), [](const Artifact *a1, const Artifact *a2) {
+        return a1->filePath() < a2->filePath();
+    });
+
+    // Headers are reported in the order in which they are first seen, which is the order
+    // that is least likely to break anything.
+    QHash<QString, int> includeCounts;
+    QStringList headers;
+    for (const Artifact * const artifact : artifacts) {
+        const CppScanResult scanResult = scanCppFile(m_cppScanner, artifact);
+        Set<QString> seenInThisFile;
+        for (const QString &header : scanResult.systemIncludes) {
+            if (!seenInThisFile.insert(header).second)
+                continue;
+            if (includeCounts[header]++ == 0)
+                headers.push_back(header);
+        }
+    }
+
+    const int minimumCount = std::max(2, int((qint64(thresholdPercent) * int(artifacts.size())
+                                              + 99) / 100));
+    QScriptValue result = engine->newArray();
+    quint32 resultIndex = 0;
+    for (const QString &header : qAsConst(headers)) {
+        if (includeCounts.value(header) >= minimumCount)
+            result.setProperty(resultIndex++, header);
+    }
+    qCDebug(lcDepScan) << "found" << resultIndex << "headers for an automatic precompiled header"
+                       << "in product" << m_product->name;
+    static_cast<ScriptEngine *>(engine)->setUsesIo();
+    return result;
+}
+
+} // namespace Internal
+} // namespace qbs
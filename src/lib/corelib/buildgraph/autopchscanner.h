@@ -0,0 +1,78 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qbs.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QBS_AUTOPCHSCANNER_H
+#define QBS_AUTOPCHSCANNER_H
+
+#include <language/forward_decls.h>
+
+#include <QtScript/qscriptvalue.h>
+
+QT_BEGIN_NAMESPACE
+class QScriptContext;
+QT_END_NAMESPACE
+
+class ScannerPlugin;
+
+namespace qbs {
+namespace Internal {
+
+// Provides the AutoPchScanner object to the cpp module's rule for automatic precompiled headers.
+// It determines the headers that are included by many of the given translation units.
+class AutoPchScanner
+{
+public:
+    explicit AutoPchScanner(const ResolvedProductPtr &product, QScriptValue targetScriptValue);
+    ~AutoPchScanner();
+
+private:
+    static QScriptValue js_commonHeaders(QScriptContext *ctx, QScriptEngine *engine,
+                                         AutoPchScanner *that);
+    QScriptValue commonHeaders(QScriptEngine *engine, const QScriptValue &inputs,
+                               int thresholdPercent);
+
+    const ResolvedProductPtr &m_product;
+    QScriptValue m_targetScriptValue;
+    ScannerPlugin *m_cppScanner = nullptr;
+};
+
+} // namespace Internal
+} // namespace qbs
+
+#endif // QBS_AUTOPCHSCANNER_H
@@ -6,6 +6,7 @@ SOURCES += \
     $$PWD/artifactcleaner.cpp \
     $$PWD/artifactsscriptvalue.cpp \
     $$PWD/artifactvisitor.cpp \
+    $$PWD/autopchscanner.cpp \
     $$PWD/buildgraph.cpp \
     $$PWD/buildgraphloader.cpp \
     $$PWD/buildgraphnode.cpp \
@@ -45,6 +46,7 @@ HEADERS += \
     $$PWD/artifactcleaner.h \
     $$PWD/artifactsscriptvalue.h \
     $$PWD/artifactvisitor.h \
+    $$PWD/autopchscanner.h \
     $$PWD/buildgraph.h \
     $$PWD/buildgraphloader.h \
     $$PWD/buildgraphnode.h \
@@ -308,6 +308,7 @@ void BuildGraphLoader::trackProjectChanges()
     bool reResolvingNecessary = false;
     if (!checkConfigCompatibility())
         reResolvingNecessary = true;
+    m_directorySnapshot.setPreviousSnapshot(restoredProject->directorySnapshot);
     if (hasProductFileChanged(allRestoredProducts, restoredProject->lastStartResolveTime,
                               buildSystemFiles, changedProducts)) {
         reResolvingNecessary = true;
@@ -344,6 +345,7 @@ void BuildGraphLoader::trackProjectChanges()
     if (!m_parameters.forceProbeExecution())
         ldr.setStoredModuleProviderInfo(restoredProject->moduleProviderInfo);
     ldr.setLastResolveTime(restoredProject->lastStartResolveTime);
+    ldr.setStoredDirectorySnapshot(m_directorySnapshot);
     QHash<QString, std::vector<ProbeConstPtr>> restoredProbes;
     for (const auto &restoredProduct : qAsConst(allRestoredProducts))
         restoredProbes.insert(restoredProduct->uniqueName(), restoredProduct->probes);
@@ -571,6 +573,26 @@ bool BuildGraphLoader::hasProductFileChanged(const std::vector<ResolvedProductPt
         const FileTime &referenceTime, Set<QString> &remainingBuildSystemFiles,
         std::vector<ResolvedProductPtr> &changedProducts)
 {
+    // All groups match against the same directory snapshot, so every directory is examined
+    // only once, and the unchanged ones do not need to be read again.
+    std::vector<QString> wildcardDirs;
+    for (const ResolvedProductPtr &product : restoredProducts) {
+        for (const GroupPtr &group : product->groups) {
+            if (!group->wildcards)
+                continue;
+            for (const auto &dirTimeStamp : group->wildcards->dirTimeStamps)
+                wildcardDirs.push_back(dirTimeStamp.first);
+        }
+    }
+    {
+        AccumulatingTimer wildcardTimer(m_parameters.logElapsedTime()
+                                        ? &m_wildcardExpansionEffort : nullptr);
+        std::sort(wildcardDirs.begin(), wildcardDirs.end());
+        wildcardDirs.erase(std::unique(wildcardDirs.begin(), wildcardDirs.end()),
+                           wildcardDirs.end());
+        m_directorySnapshot.prefetch(wildcardDirs);
+    }
+
     bool hasChanged = false;
     for (const ResolvedProductPtr &product : restoredProducts) {
         const QString filePath = product->location.filePath();
@@ -606,14 +628,15 @@ bool BuildGraphLoader::hasProductFileChanged(const std::vector<ResolvedProductPt
                 const bool reExpansionRequired = std::any_of(
                             group->wildcards->dirTimeStamps.cbegin(),
                             group->wildcards->dirTimeStamps.cend(),
-                            [](const std::pair<QString, FileTime> &pair) {
-                                return FileInfo(pair.first).lastModified() > pair.second;
+                            [this](const std::pair<QString, FileTime> &pair) {
+                                return m_directorySnapshot.directory(pair.first).lastModified
+                                        > pair.second;
                 });
                 if (!reExpansionRequired)
                     continue;
                 const Set<QString> files = group->wildcards->expandPatterns(group,
                         FileInfo::path(group->location.filePath()),
-                        product->topLevelProject()->buildDirectory);
+                        product->topLevelProject()->buildDirectory, m_directorySnapshot);
                 Set<QString> wcFiles;
                 for (const auto &sourceArtifact : group->wildcards->files)
                     wcFiles += sourceArtifact->absoluteFilePath;
@@ -660,6 +683,7 @@ void BuildGraphLoader::markTransformersForChangeTracking(
     for (const ResolvedProductPtr &product : restoredProducts) {
         if (!product->buildData)
             continue;
+        product->buildData->invalidateUpToDateState();
         for (Artifact * const artifact : filterByType<Artifact>(product->buildData->allNodes())) {
             if (artifact->transformer) {
                 artifact->transformer->prepareScriptNeedsChangeTracking = true;
@@ -953,8 +977,11 @@ void BuildGraphLoader::rescueOldBuildData(const ResolvedProductConstPtr &restore
             rad.exportedModulesAccessedInCommands
                     = oldArtifact->transformer->exportedModulesAccessedInCommands;
             rad.lastCommandExecutionTime = oldArtifact->transformer->lastCommandExecutionTime;
+            rad.lastDuration = oldArtifact->transformer->lastDuration;
             rad.lastPrepareScriptExecutionTime
                     = oldArtifact->transformer->lastPrepareScriptExecutionTime;
+            rad.rule = oldArtifact->transformer->rule;
+            rad.inputFileTags = oldArtifact->transformer->inputFileTags();
             const ChildrenInfo &childrenInfo = childLists.value(oldArtifact);
             for (Artifact * const child : qAsConst(childrenInfo.children)) {
                 rad.children.emplace_back(child->product->name,
@@ -46,6 +46,7 @@
 
 #include <language/forward_decls.h>
 #include <logging/logger.h>
+#include <tools/directorysnapshot.h>
 #include <tools/setupprojectparameters.h>
 
 #include <QtCore/qprocess.h>
@@ -141,6 +142,7 @@ private:
     QStringList m_artifactsRemovedFromDisk;
     std::unordered_map<QString, std::vector<SourceArtifactConstPtr>> m_changedSourcesByProduct;
     Set<QString> m_productsWhoseArtifactsNeedUpdate;
+    DirectorySnapshot m_directorySnapshot;
     qint64 m_wildcardExpansionEffort = 0;
     qint64 m_propertyComparisonEffort = 0;
 
@@ -40,6 +40,7 @@
 #include "depscanner.h"
 #include "artifact.h"
 #include "projectbuilddata.h"
+#include "rawscanresults.h"
 #include "buildgraph.h"
 #include "transformer.h"
 
@@ -52,12 +53,18 @@
 #include <jsextensions/moduleproperties.h>
 #include <plugins/scanner/scanner.h>
 #include <tools/fileinfo.h>
+#include <tools/parallelutils.h>
 #include <tools/stringconstants.h>
 
+#include <QtCore/qdir.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qhash.h>
 #include <QtCore/qvariant.h>
 
 #include <QtScript/qscriptcontext.h>
 
+#include <algorithm>
+
 namespace qbs {
 namespace Internal {
 
@@ -68,6 +75,16 @@ QString DependencyScanner::id() const
     return m_id;
 }
 
+std::vector<std::optional<QStringList>> DependencyScanner::collectDependenciesOfFiles(
+        Artifact *artifact, const std::vector<FileResourceBase *> &files, const char *fileTags)
+{
+    std::vector<std::optional<QStringList>> result;
+    result.reserve(files.size());
+    for (FileResourceBase * const file : files)
+        result.push_back(collectDependencies(artifact, file, fileTags));
+    return result;
+}
+
 static QStringList collectCppIncludePaths(const QVariantMap &modules)
 {
     QStringList result;
@@ -76,6 +93,10 @@ static QStringList collectCppIncludePaths(const QVariantMap &modules)
         return result;
 
     result << cpp.value(QStringLiteral("includePaths")).toStringList();
+    const QString compiledModuleDirectory
+            = cpp.value(QStringLiteral("_compiledModuleDirectory")).toString();
+    if (!compiledModuleDirectory.isEmpty())
+        result << compiledModuleDirectory;
     const bool useSystemHeaders
             = cpp.value(QStringLiteral("treatSystemHeadersAsDependencies")).toBool();
     if (useSystemHeaders) {
@@ -88,6 +109,12 @@ static QStringList collectCppIncludePaths(const QVariantMap &modules)
     return result;
 }
 
+static QString compiledModuleSuffix(const PropertyMapInternal *properties)
+{
+    return properties->moduleProperty(StringConstants::cppModule(),
+                                      QStringLiteral("_compiledModuleSuffix")).toString();
+}
+
 PluginDependencyScanner::PluginDependencyScanner(ScannerPlugin *plugin)
     : m_plugin(plugin)
 {
@@ -100,36 +127,122 @@ QStringList PluginDependencyScanner::collectSearchPaths(Artifact *artifact)
     return {};
 }
 
+// A module import becomes a dependency on the compiled module interface, which is looked up
+// in the search paths. It is dropped if the product does not build C++ modules.
+static void addDependency(Set<QString> &result, const QString &baseDirOfInFilePath,
+                          const QString &moduleSuffix, const char *filePath, int length,
+                          int flags)
+{
+    QString outFilePath = QString::fromLocal8Bit(filePath, length);
+    if (outFilePath.isEmpty())
+        return;
+    if (flags & SC_MODULE_IMPORT_FLAG) {
+        if (!moduleSuffix.isEmpty())
+            result += outFilePath.replace(QLatin1Char(':'), QLatin1Char('-')) + moduleSuffix;
+        return;
+    }
+    if (flags & SC_LOCAL_INCLUDE_FLAG) {
+        QString localFilePath = FileInfo::resolvePath(baseDirOfInFilePath, outFilePath);
+        if (FileInfo::exists(localFilePath))
+            outFilePath = localFilePath;
+    }
+    result += outFilePath;
+}
+
 QStringList PluginDependencyScanner::collectDependencies(Artifact *artifact, FileResourceBase *file,
                                                          const char *fileTags)
 {
-    Q_UNUSED(artifact);
     Set<QString> result;
     QString baseDirOfInFilePath = file->dirPath();
+    const QString moduleSuffix = compiledModuleSuffix(artifact->properties.get());
     const QString &filepath = file->filePath();
     void *scannerHandle = m_plugin->open(filepath.utf16(), fileTags, ScanForDependenciesFlag);
-    if (!scannerHandle)
-        return {};
+    if (!scannerHandle) {
+        // Plugins cannot map empty files, which have no dependencies anyway.
+        const QFileInfo fileInfo(filepath);
+        if (fileInfo.exists() && fileInfo.size() == 0)
+            return {};
+        throw ErrorInfo(Tr::tr("Cannot scan file '%1' for dependencies.")
+                        .arg(QDir::toNativeSeparators(filepath)));
+    }
     forever {
         int flags = 0;
         int length = 0;
         const char *szOutFilePath = m_plugin->next(scannerHandle, &length, &flags);
         if (szOutFilePath == nullptr)
             break;
-        QString outFilePath = QString::fromLocal8Bit(szOutFilePath, length);
-        if (outFilePath.isEmpty())
-            continue;
-        if (flags & SC_LOCAL_INCLUDE_FLAG) {
-            QString localFilePath = FileInfo::resolvePath(baseDirOfInFilePath, outFilePath);
-            if (FileInfo::exists(localFilePath))
-                outFilePath = localFilePath;
-        }
-        result += outFilePath;
+        addDependency(result, baseDirOfInFilePath, moduleSuffix, szOutFilePath, length, flags);
     }
     m_plugin->close(scannerHandle);
     return result.toList();
 }
 
+std::vector<std::optional<QStringList>> PluginDependencyScanner::collectDependenciesOfFiles(
+        Artifact *artifact, const std::vector<FileResourceBase *> &files, const char *fileTags)
+{
+    std::vector<std::optional<QStringList>> result(files.size());
+    static const size_t chunkSize = 16;
+    std::vector<std::pair<size_t, size_t>> chunks;
+    for (size_t i = 0; i < files.size(); i += chunkSize)
+        chunks.emplace_back(i, std::min(i + chunkSize, files.size()));
+    const auto scanChunk = [&](const std::pair<size_t, size_t> &chunk) {
+        scanBatch(artifact, files, chunk.first, chunk.second, fileTags, result);
+    };
+    if (m_plugin->flags & ScannerIsThreadSafe) {
+        parallelForEach(chunks, scanChunk, QThread::idealThreadCount(), 1);
+    } else {
+        for (const auto &chunk : chunks)
+            scanChunk(chunk);
+    }
+    return result;
+}
+
+// Plugins without a batch entry point are driven file by file via open/next/close.
+// Files the plugin reports as failed are left without a result.
+void PluginDependencyScanner::scanBatch(Artifact *artifact,
+                                        const std::vector<FileResourceBase *> &files,
+                                        size_t begin, size_t end, const char *fileTags,
+                                        std::vector<std::optional<QStringList>> &result)
+{
+    if (!(m_plugin->flags & ScannerSupportsBatchScanning)) {
+        for (size_t i = begin; i < end; ++i) {
+            try {
+                result[i] = collectDependencies(artifact, files[i], fileTags);
+            } catch (const ErrorInfo &) {
+                // Reported when the file gets scanned on its own.
+            }
+        }
+        return;
+    }
+
+    std::vector<const unsigned short *> filePaths;
+    filePaths.reserve(end - begin);
+    for (size_t i = begin; i < end; ++i)
+        filePaths.push_back(files[i]->filePath().utf16());
+    ScanBatchResult batchResult{};
+    void * const batch = m_plugin->scanBatch(filePaths.data(), int(filePaths.size()), fileTags,
+                                             ScanForDependenciesFlag, &batchResult);
+    if (!batch)
+        return;
+    const QString moduleSuffix = compiledModuleSuffix(artifact->properties.get());
+    for (size_t i = begin; i < end; ++i) {
+        const size_t indexInBatch = i - begin;
+        if (batchResult.fileErrors[indexInBatch] != 0)
+            continue;
+        Set<QString> dependencies;
+        const QString baseDirOfInFilePath = files[i]->dirPath();
+        for (int j = batchResult.fileOffsets[indexInBatch];
+             j < batchResult.fileOffsets[indexInBatch + 1]; ++j) {
+            const ScannedDependency &dependency = batchResult.dependencies[j];
+            addDependency(dependencies, baseDirOfInFilePath, moduleSuffix,
+                          batchResult.arena + dependency.offset, dependency.size,
+                          dependency.flags);
+        }
+        result[i] = dependencies.toList();
+    }
+    m_plugin->releaseBatch(batch);
+}
+
 bool PluginDependencyScanner::recursive() const
 {
     return m_plugin->flags & ScannerRecursiveDependencies;
@@ -145,6 +258,14 @@ QString PluginDependencyScanner::createId() const
     return QString::fromLatin1(m_plugin->name);
 }
 
+// The raw results only depend on the properties if C++ modules are built. Products that agree
+// on the compiled module format can still share them.
+quint64 PluginDependencyScanner::propertiesFingerprint(const PropertyMapConstPtr &properties) const
+{
+    const QString moduleSuffix = compiledModuleSuffix(properties.get());
+    return moduleSuffix.isEmpty() ? 0 : qHash(moduleSuffix, 0);
+}
+
 bool PluginDependencyScanner::areModulePropertiesCompatible(const PropertyMapConstPtr &m1,
                                                             const PropertyMapConstPtr &m2) const
 {
@@ -202,6 +323,11 @@ bool UserDependencyScanner::areModulePropertiesCompatible(const PropertyMapConst
     return m1 == m2 || *m1 == *m2;
 }
 
+quint64 UserDependencyScanner::propertiesFingerprint(const PropertyMapConstPtr &properties) const
+{
+    return properties->fingerprint();
+}
+
 class ScriptEngineActiveFlagGuard
 {
     ScriptEngine *m_engine;
@@ -266,5 +392,62 @@ QStringList UserDependencyScanner::evaluate(const Artifact *artifact,
     return list;
 }
 
+CppScanResult scanCppFile(ScannerPlugin *scanner, const Artifact *artifact)
+{
+    static const std::pair<FileTag, FileTag> tagMapping[] = {
+        {"cpp.combine", "cpp"}, {"cpp.unity", "cpp"}, {"objcpp.combine", "objcpp"}
+    };
+    const QString &filepath = artifact->filePath();
+    CppScanResult &scanResult = artifact->product->topLevelProject()->buildData->rawScanResults
+            .findCppScanResult(artifact);
+    if (scanResult.lastScanTime < artifact->timestamp()) {
+        FileTags tags = artifact->fileTags();
+        for (const auto &mapping : tagMapping) {
+            if (tags.contains(mapping.first)) {
+                tags.remove(mapping.first);
+                tags.insert(mapping.second);
+            }
+        }
+        const QByteArray tagsForScanner = tags.toStringList().join(QLatin1Char(',')).toLatin1();
+        void *opaq = scanner->open(filepath.utf16(), tagsForScanner.constData(),
+                                   ScanForDependenciesFlag | ScanForFileTagsFlag);
+        if (!opaq || !scanner->additionalFileTags)
+            return scanResult;
+
+        scanResult.additionalFileTags.clear();
+        scanResult.includedMocCppFiles.clear();
+        scanResult.systemIncludes.clear();
+        int length = 0;
+        const char **szFileTagsFromScanner = scanner->additionalFileTags(opaq, &length);
+        if (szFileTagsFromScanner) {
+            for (int i = length; --i >= 0;)
+                scanResult.additionalFileTags += szFileTagsFromScanner[i];
+        }
+
+        forever {
+            int flags = 0;
+            const char *szOutFilePath = scanner->next(opaq, &length, &flags);
+            if (szOutFilePath == nullptr)
+                break;
+            const QString includedFilePath = QString::fromLocal8Bit(szOutFilePath, length);
+            if (includedFilePath.isEmpty() || (flags & SC_MODULE_IMPORT_FLAG))
+                continue;
+            if (flags & SC_GLOBAL_INCLUDE_FLAG)
+                scanResult.systemIncludes.push_back(includedFilePath);
+            QString includedFileName = FileInfo::fileName(includedFilePath);
+            if (includedFileName.startsWith(QLatin1String("moc_"))
+                    && includedFileName.endsWith(QLatin1String(".cpp"))) {
+                includedFileName.remove(0, 4);
+                includedFileName.chop(4);
+                scanResult.includedMocCppFiles.push_back(includedFileName);
+            }
+        }
+
+        scanner->close(opaq);
+        scanResult.lastScanTime = FileTime::currentTime();
+    }
+    return scanResult;
+}
+
 } // namespace Internal
 } // namespace qbs
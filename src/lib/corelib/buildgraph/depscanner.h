@@ -43,22 +43,27 @@
 #include <language/forward_decls.h>
 #include <language/filetags.h>
 #include <language/preparescriptobserver.h>
+#include <tools/qbs_export.h>
 
 #include <QtCore/qstringlist.h>
 
 #include <QtScript/qscriptvalue.h>
 
+#include <optional>
+#include <vector>
+
 class ScannerPlugin;
 
 namespace qbs {
 namespace Internal {
 
 class Artifact;
+class CppScanResult;
 class FileResourceBase;
 class Logger;
 class ScriptEngine;
 
-class DependencyScanner
+class QBS_AUTOTEST_EXPORT DependencyScanner
 {
 public:
     virtual ~DependencyScanner() = default;
@@ -68,10 +73,23 @@ public:
     virtual QStringList collectSearchPaths(Artifact *artifact) = 0;
     virtual QStringList collectDependencies(Artifact *artifact, FileResourceBase *file,
                                             const char *fileTags) = 0;
+
+    // Scanners that return true here can scan several files in one go
+    // via collectDependenciesOfFiles(), possibly in parallel. Files that could not be scanned
+    // that way have no value in the result and must be scanned via collectDependencies().
+    virtual bool supportsBatchScanning() const { return false; }
+    virtual std::vector<std::optional<QStringList>> collectDependenciesOfFiles(
+            Artifact *artifact, const std::vector<FileResourceBase *> &files,
+            const char *fileTags);
     virtual bool recursive() const = 0;
     virtual const void *key() const = 0;
     virtual bool areModulePropertiesCompatible(const PropertyMapConstPtr &m1,
                                                const PropertyMapConstPtr &m2) const = 0;
+
+    // A hash of the module properties that are relevant to this scanner.
+    // Properties for which areModulePropertiesCompatible() returns true must have the same
+    // fingerprint.
+    virtual quint64 propertiesFingerprint(const PropertyMapConstPtr &properties) const = 0;
     virtual bool cacheIsPerFile() const = 0;
 
 private:
@@ -80,7 +98,7 @@ private:
     mutable QString m_id;
 };
 
-class PluginDependencyScanner : public DependencyScanner
+class QBS_AUTOTEST_EXPORT PluginDependencyScanner : public DependencyScanner
 {
 public:
     PluginDependencyScanner(ScannerPlugin *plugin);
@@ -89,13 +107,22 @@ private:
     QStringList collectSearchPaths(Artifact *artifact) override;
     QStringList collectDependencies(Artifact *artifact, FileResourceBase *file,
                                     const char *fileTags) override;
+    bool supportsBatchScanning() const override { return true; }
+    std::vector<std::optional<QStringList>> collectDependenciesOfFiles(
+            Artifact *artifact, const std::vector<FileResourceBase *> &files,
+            const char *fileTags) override;
     bool recursive() const override;
     const void *key() const override;
     QString createId() const override;
     bool areModulePropertiesCompatible(const PropertyMapConstPtr &m1,
                                        const PropertyMapConstPtr &m2) const override;
+    quint64 propertiesFingerprint(const PropertyMapConstPtr &properties) const override;
     bool cacheIsPerFile() const override { return false; }
 
+    void scanBatch(Artifact *artifact, const std::vector<FileResourceBase *> &files,
+                   size_t begin, size_t end, const char *fileTags,
+                   std::vector<std::optional<QStringList>> &result);
+
     ScannerPlugin* m_plugin;
 };
 
@@ -113,6 +140,7 @@ private:
     QString createId() const override;
     bool areModulePropertiesCompatible(const PropertyMapConstPtr &m1,
                                        const PropertyMapConstPtr &m2) const override;
+    quint64 propertiesFingerprint(const PropertyMapConstPtr &properties) const override;
     bool cacheIsPerFile() const override { return true; }
 
     QStringList evaluate(const Artifact *artifact, const FileResourceBase *fileToScan, const PrivateScriptFunction &script);
@@ -123,6 +151,10 @@ private:
     ResolvedProduct *m_product;
 };
 
+// Runs the C++ scanner plugin on the given file, looking for both dependencies and file tags.
+// The result is cached in the build graph and only recomputed if the file has changed.
+CppScanResult scanCppFile(ScannerPlugin *scanner, const Artifact *artifact);
+
 } // namespace Internal
 } // namespace qbs
 
@@ -61,6 +61,8 @@
 #include <logging/translator.h>
 #include <tools/error.h>
 #include <tools/fileinfo.h>
+#include <tools/jobserver.h>
+#include <tools/parallelutils.h>
 #include <tools/preferences.h>
 #include <tools/profiling.h>
 #include <tools/progressobserver.h>
@@ -70,6 +72,7 @@
 #include <tools/stringconstants.h>
 
 #include <QtCore/qdir.h>
+#include <QtCore/qthread.h>
 #include <QtCore/qtimer.h>
 
 #include <algorithm>
@@ -80,9 +83,24 @@
 namespace qbs {
 namespace Internal {
 
+static qint64 expectedDuration(const BuildGraphNode *node)
+{
+    if (node->type() != BuildGraphNode::ArtifactNodeType)
+        return -1;
+    const auto artifact = static_cast<const Artifact *>(node);
+    return artifact->transformer ? artifact->transformer->lastDuration : -1;
+}
+
 bool Executor::ComparePriority::operator() (const BuildGraphNode *x, const BuildGraphNode *y) const
 {
-    return x->product->buildData->buildPriority() < y->product->buildData->buildPriority();
+    const unsigned int xPriority = x->product->buildData->buildPriority();
+    const unsigned int yPriority = y->product->buildData->buildPriority();
+    if (xPriority != yPriority)
+        return xPriority < yPriority;
+
+    // Start the jobs that took longest last time first, so they do not extend the build
+    // by being started late.
+    return expectedDuration(x) < expectedDuration(y);
 }
 
 
@@ -92,12 +110,10 @@ Executor::Executor(Logger logger, QObject *parent)
     , m_logger(std::move(logger))
     , m_progressObserver(nullptr)
     , m_state(ExecutorIdle)
-    , m_cancelationTimer(new QTimer(this))
 {
     m_inputArtifactScanContext = new InputArtifactScannerContext;
-    m_cancelationTimer->setSingleShot(false);
-    m_cancelationTimer->setInterval(1000);
-    connect(m_cancelationTimer, &QTimer::timeout, this, &Executor::checkForCancellation);
+    connect(&JobServer::instance(), &JobServer::tokenReleased,
+            this, &Executor::startWaitingTransformers, Qt::QueuedConnection);
 }
 
 Executor::~Executor()
@@ -108,15 +124,12 @@ Executor::~Executor()
     delete m_productInstaller;
 }
 
-FileTime Executor::recursiveFileTime(const QString &filePath) const
+static FileTime recursiveFileTime(const QString &filePath)
 {
     FileTime newest;
     FileInfo fileInfo(filePath);
-    if (!fileInfo.exists()) {
-        const QString nativeFilePath = QDir::toNativeSeparators(filePath);
-        m_logger.qbsWarning() << Tr::tr("File '%1' not found.").arg(nativeFilePath);
+    if (!fileInfo.exists())
         return newest;
-    }
     newest = std::max(fileInfo.lastModified(), fileInfo.lastStatusChange());
     if (!fileInfo.isDir())
         return newest;
@@ -130,20 +143,61 @@ FileTime Executor::recursiveFileTime(const QString &filePath) const
     return newest;
 }
 
+bool Executor::mustRetrieveSourceFileTimestamp(const Artifact *artifact) const
+{
+    return !m_useChangedFiles
+            || (!m_changedFiles.contains(artifact->filePath())
+                && !artifact->timestamp().isValid());
+}
+
 void Executor::retrieveSourceFileTimestamp(Artifact *artifact) const
 {
     QBS_CHECK(artifact->artifactType == Artifact::SourceFile);
 
-    if (m_buildOptions.changedFiles().empty())
+    if (mustRetrieveSourceFileTimestamp(artifact))
         artifact->setTimestamp(recursiveFileTime(artifact->filePath()));
-    else if (m_buildOptions.changedFiles().contains(artifact->filePath()))
+    else if (m_changedFiles.contains(artifact->filePath()))
         artifact->setTimestamp(FileTime::currentTime());
-    else if (!artifact->timestamp().isValid())
-        artifact->setTimestamp(recursiveFileTime(artifact->filePath()));
+    finishSourceFileTimestampRetrieval(artifact);
+}
+
+// Looking up the timestamps one after the other is dominated by file system latency,
+// in particular on network file systems, so we do it for all artifacts in parallel.
+void Executor::retrieveSourceFileTimestamps(const std::vector<Artifact *> &artifacts)
+{
+    std::vector<std::pair<Artifact *, FileTime>> timestamps;
+    for (Artifact * const artifact : artifacts) {
+        QBS_CHECK(artifact->artifactType == Artifact::SourceFile);
+        if (mustRetrieveSourceFileTimestamp(artifact))
+            timestamps.emplace_back(artifact, FileTime());
+        else if (m_changedFiles.contains(artifact->filePath()))
+            markSourceFileChanged(artifact, FileTime::currentTime());
+    }
+    parallelForEach(timestamps, [](std::pair<Artifact *, FileTime> &artifactAndTimestamp) {
+        artifactAndTimestamp.second = recursiveFileTime(artifactAndTimestamp.first->filePath());
+    }, m_buildOptions.maxJobCount());
+    for (const auto &artifactAndTimestamp : timestamps) {
+        if (artifactAndTimestamp.first->timestamp() != artifactAndTimestamp.second)
+            markSourceFileChanged(artifactAndTimestamp.first, artifactAndTimestamp.second);
+    }
+    for (Artifact * const artifact : artifacts)
+        finishSourceFileTimestampRetrieval(artifact);
+}
 
+void Executor::markSourceFileChanged(Artifact *artifact, const FileTime &timestamp)
+{
+    artifact->setTimestamp(timestamp);
+    m_productsWithChangedSources.insert(artifact->product.get());
+}
+
+void Executor::finishSourceFileTimestampRetrieval(Artifact *artifact) const
+{
     artifact->timestampRetrieved = true;
-    if (!artifact->timestamp().isValid())
+    if (!artifact->timestamp().isValid()) {
+        const QString nativeFilePath = QDir::toNativeSeparators(artifact->filePath());
+        m_logger.qbsWarning() << Tr::tr("File '%1' not found.").arg(nativeFilePath);
         throw ErrorInfo(Tr::tr("Source file '%1' has disappeared.").arg(artifact->filePath()));
+    }
 }
 
 void Executor::build()
@@ -160,6 +214,9 @@ void Executor::setProject(const TopLevelProjectPtr &project)
 {
     m_project = project;
     m_allProducts = project->allProducts();
+    m_allProductsByName.clear();
+    for (const ResolvedProductPtr &p : m_allProducts)
+        m_allProductsByName.insert(std::make_pair(p->uniqueName(), p.get()));
     m_projectsByName.clear();
     m_projectsByName.insert(std::make_pair(project->name, project.get()));
     for (const ResolvedProjectPtr &p : project->allSubProjects())
@@ -221,6 +278,9 @@ void Executor::doBuild()
                         << m_buildOptions.maxJobCount();
     }
     QBS_CHECK(m_state == ExecutorIdle);
+    JobServer::instance().registerClient(m_buildOptions.maxJobCount(),
+                                         m_buildOptions.provideMakeJobServer());
+    m_registeredWithJobServer = true;
     m_leaves = Leaves();
     m_error.clear();
     m_explicitlyCanceled = false;
@@ -230,6 +290,11 @@ void Executor::doBuild()
     m_productsOfFilesToConsider.clear();
     m_artifactsRemovedFromDisk.clear();
     m_jobCountPerPool.clear();
+    m_changedFiles = Set<QString>::fromList(m_buildOptions.changedFiles());
+    m_useChangedFiles = !m_changedFiles.empty() || m_buildOptions.changedFilesComplete();
+    m_productsWithChangedSources.clear();
+    m_skippedProducts.clear();
+    m_buildStartTime = FileTime::currentTime();
 
     setupJobLimits();
 
@@ -264,6 +329,7 @@ void Executor::doBuild()
     QBS_CHECK(!m_project->buildData->evaluationContext);
     m_project->buildData->evaluationContext = std::make_shared<RulesEvaluationContext>(m_logger);
     m_evalContext = m_project->buildData->evaluationContext;
+    m_evalContext->setObserver(m_progressObserver); // For checking the cancel flag.
 
     m_elapsedTimeRules = m_elapsedTimeScanners = m_elapsedTimeInstalling = 0;
     m_evalContext->engine()->enableProfiling(m_buildOptions.logElapsedTime());
@@ -280,8 +346,8 @@ void Executor::doBuild()
 
     addExecutorJobs();
     syncFileDependencies();
-    prepareAllNodes();
     prepareProducts();
+    prepareAllNodes();
     setupRootNodes();
     prepareReachableNodes();
     setupProgressObserver();
@@ -290,8 +356,6 @@ void Executor::doBuild()
         qCDebug(lcExec) << "Nothing to do at all, finishing.";
         QTimer::singleShot(0, this, &Executor::finish); // Don't call back on the caller.
     }
-    if (m_progressObserver)
-        m_cancelationTimer->start();
 }
 
 void Executor::setBuildOptions(const BuildOptions &buildOptions)
@@ -346,6 +410,13 @@ void Executor::updateLeaves(BuildGraphNode *node, NodeSet &seenNodes)
 bool Executor::scheduleJobs()
 {
     QBS_CHECK(m_state == ExecutorRunning);
+    while (!m_transformersWaitingForToken.empty() && !m_availableJobs.empty()
+           && JobServer::instance().tryAcquireToken()) {
+        const TransformerPtr transformer = m_transformersWaitingForToken.front();
+        m_transformersWaitingForToken.pop_front();
+        startTransformer(transformer);
+    }
+
     std::vector<BuildGraphNode *> delayedLeaves;
     while (!m_leaves.empty() && !m_availableJobs.empty()) {
         BuildGraphNode * const nodeToBuild = m_leaves.top();
@@ -364,6 +435,10 @@ bool Executor::scheduleJobs()
                 qCDebug(lcExec).noquote() << "node delayed due to occupied job pool:"
                                           << nodeToBuild->toString();
                 delayedLeaves.push_back(nodeToBuild);
+            } else if (schedulingBlockedBySystemResources(nodeToBuild)) {
+                qCDebug(lcExec).noquote() << "node delayed due to low system resources:"
+                                          << nodeToBuild->toString();
+                delayedLeaves.push_back(nodeToBuild);
             } else {
                 nodeToBuild->accept(this);
             }
@@ -380,7 +455,37 @@ bool Executor::scheduleJobs()
     }
     for (BuildGraphNode * const delayedLeaf : delayedLeaves)
         m_leaves.push(delayedLeaf);
-    return !m_leaves.empty() || !m_processingJobs.empty();
+
+    // Tokens returned by other processes do not notify us, so we have to ask again.
+    if (!m_transformersWaitingForToken.empty() && !m_jobTokenPollPending
+            && JobServer::instance().hasExternalTokens()) {
+        m_jobTokenPollPending = true;
+        QTimer::singleShot(20, this, [this] {
+            m_jobTokenPollPending = false;
+            startWaitingTransformers();
+        });
+    }
+
+    return !m_leaves.empty() || !m_processingJobs.empty()
+            || !m_transformersWaitingForToken.empty();
+}
+
+void Executor::startWaitingTransformers()
+{
+    if (m_state != ExecutorRunning || m_transformersWaitingForToken.empty())
+        return;
+    if (m_evalContext->engine()->isActive()) {
+        QTimer::singleShot(0, this, &Executor::startWaitingTransformers);
+        return;
+    }
+    try {
+        if (!scheduleJobs()) {
+            qCDebug(lcExec) << "Nothing left to build; finishing.";
+            finish();
+        }
+    } catch (const ErrorInfo &error) {
+        handleError(error);
+    }
 }
 
 bool Executor::schedulingBlockedByJobLimit(const BuildGraphNode *node)
@@ -423,6 +528,73 @@ bool Executor::schedulingBlockedByJobLimit(const BuildGraphNode *node)
     return false;
 }
 
+// Jobs from pools that have not been seen to use more memory than this are not held back,
+// so the CPU cores can be kept busy while memory-hungry jobs have to wait.
+static const qint64 cheapJobMemoryUsage = qint64(256) * 1024 * 1024;
+
+bool Executor::schedulingBlockedBySystemResources(const BuildGraphNode *node)
+{
+    // If nothing is running, holding back the job would not free up anything.
+    if (!m_buildOptions.adaptiveJobScheduling() || m_processingJobs.empty())
+        return false;
+    if (node->type() != BuildGraphNode::ArtifactNodeType)
+        return false;
+    const auto artifact = static_cast<const Artifact *>(node);
+    if (artifact->artifactType == Artifact::SourceFile)
+        return false;
+
+    if (!m_systemResourcesTimer.isValid() || m_systemResourcesTimer.elapsed() >= 200) {
+        m_systemResources = SystemResources::query();
+        m_systemResourcesTimer.start();
+    }
+    if (m_systemResources.memoryFullPressure >= 10)
+        return true; // The system is thrashing.
+
+    const qint64 expectedUsage = expectedMemoryUsage(artifact->transformer.get());
+    if (expectedUsage < cheapJobMemoryUsage)
+        return false;
+    if (m_systemResources.memoryPressure >= 10)
+        return true;
+    if (m_systemResources.loadAverage >= 2 * QThread::idealThreadCount())
+        return true;
+    if (m_systemResources.availableMemory < 0)
+        return false;
+
+    // Running jobs might not have reached their peak yet, so we assume the worst.
+    qint64 reservedMemory = std::max(qint64(512) * 1024 * 1024,
+                                     m_systemResources.totalMemory / 20);
+    for (auto it = m_processingJobs.cbegin(); it != m_processingJobs.cend(); ++it)
+        reservedMemory += expectedMemoryUsage(it.value().get());
+    return m_systemResources.availableMemory - reservedMemory < expectedUsage;
+}
+
+qint64 Executor::expectedMemoryUsage(const Transformer *transformer) const
+{
+    const auto &peakUsagePerPool = m_project->buildData->peakMemoryUsagePerJobPool;
+    qint64 usage = 0;
+    for (const QString &jobPool : transformer->jobPools()) {
+        const auto it = peakUsagePerPool.find(jobPool);
+        if (it != peakUsagePerPool.cend())
+            usage = std::max(usage, it->second);
+    }
+    return usage;
+}
+
+void Executor::recordMemoryUsage(const ExecutorJob *job, const Transformer *transformer)
+{
+    const qint64 usage = job->peakMemoryUsage();
+    if (usage < 0)
+        return;
+    for (const QString &jobPool : transformer->jobPools()) {
+        qint64 &peakUsage = m_project->buildData->peakMemoryUsagePerJobPool[jobPool];
+
+        // Adapt to changes in the project, but never expect less than we have just seen.
+        peakUsage = std::max(usage, (peakUsage + usage) / 2);
+        qCDebug(lcExec) << "expected memory usage of job pool" << jobPool << "is now"
+                        << peakUsage << "bytes";
+    }
+}
+
 bool Executor::isUpToDate(Artifact *artifact) const
 {
     QBS_CHECK(artifact->artifactType == Artifact::Generated);
@@ -564,7 +736,12 @@ void Executor::finishJob(ExecutorJob *job, bool success)
     m_processingJobs.erase(it);
     m_availableJobs.push_back(job);
     updateJobCounts(transformer.get(), -1);
+    JobServer::instance().releaseToken();
+    if (m_buildOptions.adaptiveJobScheduling())
+        recordMemoryUsage(job, transformer.get());
     if (success) {
+        if (!m_buildOptions.dryRun())
+            m_measuredDurations.emplace_back(transformer, job->elapsedTime());
         m_project->buildData->setDirty();
         for (Artifact * const artifact : qAsConst(transformer->outputs)) {
             if (artifact->alwaysUpdated) {
@@ -722,6 +899,9 @@ void Executor::cancelJobs()
         return;
     qCDebug(lcExec) << "Canceling all jobs.";
     setState(ExecutorCanceling);
+    for (const TransformerPtr &transformer : m_transformersWaitingForToken)
+        updateJobCounts(transformer.get(), -1);
+    m_transformersWaitingForToken.clear();
     const auto jobs = m_processingJobs.keys();
     for (ExecutorJob *job : jobs)
         job->cancel();
@@ -734,6 +914,8 @@ void Executor::setupProgressObserver()
     int totalEffort = 1; // For the effort after the last rule application;
     for (const auto &product : qAsConst(m_productsToBuild)) {
         QBS_CHECK(product->buildData);
+        if (m_skippedProducts.contains(product.get()))
+            continue;
         const auto filtered = filterByType<RuleNode>(product->buildData->allNodes());
         totalEffort += std::distance(filtered.begin(), filtered.end());
     }
@@ -774,6 +956,7 @@ void Executor::addExecutorJobs()
         job->setObjectName(QStringLiteral("J%1").arg(i));
         job->setDryRun(m_buildOptions.dryRun());
         job->setEchoMode(m_buildOptions.echoMode());
+        job->setTrackMemoryUsage(m_buildOptions.adaptiveJobScheduling());
         m_availableJobs.push_back(job);
         connect(job, &ExecutorJob::reportCommandDescription,
                 this, &Executor::reportCommandDescription);
@@ -892,6 +1075,7 @@ void Executor::rescueOldBuildData(Artifact *artifact, bool *childrenAdded = null
         artifact->transformer->exportedModulesAccessedInCommands
                 = rad.exportedModulesAccessedInCommands;
         artifact->transformer->lastCommandExecutionTime = rad.lastCommandExecutionTime;
+        artifact->transformer->lastDuration = rad.lastDuration;
         artifact->transformer->lastPrepareScriptExecutionTime = rad.lastPrepareScriptExecutionTime;
         artifact->transformer->commandsNeedChangeTracking = true;
         artifact->setTimestamp(rad.timeStamp);
@@ -1009,12 +1193,25 @@ void Executor::runTransformer(const TransformerPtr &transformer)
         }
     }
 
-    QBS_CHECK(!m_availableJobs.empty());
-    ExecutorJob *job = m_availableJobs.takeFirst();
     for (Artifact * const artifact : qAsConst(transformer->outputs))
         artifact->buildState = BuildGraphNode::Building;
-    m_processingJobs.insert(job, transformer);
     updateJobCounts(transformer.get(), 1);
+
+    // The job token is shared with other builds in this process, and possibly with
+    // other processes.
+    if (!JobServer::instance().tryAcquireToken()) {
+        qCDebug(lcExec) << "No job token available, delaying transformer.";
+        m_transformersWaitingForToken.push_back(transformer);
+        return;
+    }
+    startTransformer(transformer);
+}
+
+void Executor::startTransformer(const TransformerPtr &transformer)
+{
+    QBS_CHECK(!m_availableJobs.empty());
+    ExecutorJob *job = m_availableJobs.takeFirst();
+    m_processingJobs.insert(job, transformer);
     job->run(transformer.get());
 }
 
@@ -1100,6 +1297,8 @@ void Executor::checkForUnbuiltProducts()
                 product->buildData->removeFromRescuableArtifactData(it.key());
                 m_artifactsRemovedFromDisk << it.key();
             }
+            if (!m_skippedProducts.contains(product.get()))
+                recordUpToDateState(product.get());
         }
     }
 
@@ -1137,16 +1336,26 @@ void Executor::finish()
     QBS_ASSERT(!m_evalContext || !m_evalContext->engine()->isActive(), /* ignore */);
 
     checkForUnbuiltProducts();
+
+    // Applied only now, as the durations are part of the ordering of m_leaves.
+    for (const auto &measuredDuration : m_measuredDurations)
+        measuredDuration.first->lastDuration = measuredDuration.second;
+    m_measuredDurations.clear();
+    if (m_registeredWithJobServer) {
+        QBS_ASSERT(m_processingJobs.empty(), /* ignore */);
+        m_transformersWaitingForToken.clear();
+        JobServer::instance().unregisterClient(m_buildOptions.maxJobCount(),
+                                               m_buildOptions.provideMakeJobServer());
+        m_registeredWithJobServer = false;
+    }
     if (m_explicitlyCanceled) {
         QString message = Tr::tr(m_buildOptions.executeRulesOnly()
                                  ? "Rule execution canceled" : "Build canceled");
         m_error.append(Tr::tr("%1%2.").arg(message, configString()));
     }
     setState(ExecutorIdle);
-    if (m_progressObserver) {
+    if (m_progressObserver)
         m_progressObserver->setFinished();
-        m_cancelationTimer->stop();
-    }
 
     EmptyDirectoriesRemover(m_project.get(), m_logger)
             .removeEmptyParentDirectories(m_artifactsRemovedFromDisk);
@@ -1167,9 +1376,16 @@ void Executor::checkForCancellation()
 {
     QBS_ASSERT(m_progressObserver, return);
     if (m_state == ExecutorRunning && m_progressObserver->canceled()) {
+        qCDebug(lcExec) << "Received cancel request; canceling build.";
+        m_explicitlyCanceled = true;
         cancelJobs();
         if (m_evalContext->engine()->isActive())
             m_evalContext->engine()->cancel();
+        else if (m_processingJobs.empty()) // Only transformers waiting for a job token.
+            QTimer::singleShot(0, this, [this] {
+                if (m_state == ExecutorCanceling && m_processingJobs.empty())
+                    finish();
+            });
     }
 }
 
@@ -1187,6 +1403,134 @@ bool Executor::visit(RuleNode *ruleNode)
     return false;
 }
 
+bool Executor::productSkippingAllowed() const
+{
+    return !m_buildOptions.forceTimestampCheck() && !m_buildOptions.forceOutputCheck()
+            && m_buildOptions.filesToConsider().empty()
+            && m_activeFileTags.empty() && !m_buildOptions.executeRulesOnly()
+            && !m_buildOptions.dryRun() && !m_buildOptions.removeExistingInstallation();
+}
+
+bool Executor::isProductUnchanged(const ResolvedProduct *product,
+                                  std::unordered_map<const ResolvedProduct *, bool> &cache)
+{
+    if (!product->buildData)
+        return true;
+    const auto it = cache.find(product);
+    if (it != cache.end())
+        return it->second;
+    cache[product] = false; // Also protects against dependency cycles.
+
+    const ProductUpToDateState &state = product->buildData->upToDateState();
+    if (!state.valid)
+        return false;
+
+    // For products that are not part of this build, we did not look at the sources,
+    // so we just check whether anything they depend on has changed.
+    if (m_productsByName.find(product->uniqueName()) != m_productsByName.cend()) {
+        if (!productSkippingAllowed() || m_productsWithChangedSources.contains(product))
+            return false;
+        for (const QString &importedFile : state.importedFiles) {
+            auto timeIt = m_importedFileTimes.find(importedFile);
+            if (timeIt == m_importedFileTimes.end()) {
+                timeIt = m_importedFileTimes.insert(
+                            std::make_pair(importedFile,
+                                           FileInfo(importedFile).lastModified())).first;
+            }
+            if (!timeIt->second.isValid() || timeIt->second > state.buildTime)
+                return false;
+        }
+        for (const auto &envValue : state.relevantEnvValues) {
+            if (product->buildEnvironment.value(envValue.first) != envValue.second)
+                return false;
+        }
+    }
+
+    for (const ResolvedProductPtr &dependency : product->dependencies) {
+        if (!isProductUnchanged(dependency.get(), cache))
+            return false;
+    }
+    for (const QString &otherProductName : state.otherProducts) {
+        const auto otherIt = m_allProductsByName.find(otherProductName);
+        if (otherIt == m_allProductsByName.cend() || !isProductUnchanged(otherIt->second, cache))
+            return false;
+    }
+
+    cache[product] = true;
+    return true;
+}
+
+/**
+  * Determines the products that do not need to be looked at in this build, because neither
+  * they nor anything they depend on have changed since they were last built successfully.
+  * All other products lose their up-to-date state.
+  */
+void Executor::skipUnchangedProducts()
+{
+    m_importedFileTimes.clear();
+    std::unordered_map<const ResolvedProduct *, bool> cache;
+    for (const ResolvedProductPtr &product : m_allProducts) {
+        if (!product->buildData)
+            continue;
+        if (isProductUnchanged(product.get(), cache)) {
+            if (m_productsByName.find(product->uniqueName()) != m_productsByName.cend())
+                m_skippedProducts.insert(product.get());
+        } else if (product->buildData->upToDateState().valid) {
+            product->buildData->invalidateUpToDateState();
+            m_project->buildData->setDirty();
+        }
+    }
+    m_importedFileTimes.clear();
+
+    for (const ResolvedProduct * const product : qAsConst(m_skippedProducts))
+        qCDebug(lcExec) << "product" << product->uniqueName() << "is unchanged, skipping";
+}
+
+void Executor::recordUpToDateState(const ResolvedProduct *product)
+{
+    if (!productSkippingAllowed())
+        return;
+    ProductUpToDateState state;
+    Set<QString> otherProducts;
+    Set<QString> importedFiles;
+    QHash<QString, QString> relevantEnvValues;
+    for (BuildGraphNode * const node : qAsConst(product->buildData->allNodes())) {
+        for (const BuildGraphNode * const child : qAsConst(node->children)) {
+            const ResolvedProduct * const childProduct = child->product.get();
+            if (childProduct && childProduct != product)
+                otherProducts.insert(childProduct->uniqueName());
+        }
+        if (node->type() != BuildGraphNode::ArtifactNodeType)
+            continue;
+        const Transformer * const transformer = static_cast<Artifact *>(node)->transformer.get();
+        if (!transformer)
+            continue;
+        if (transformer->alwaysRun || transformer->markedForRerun)
+            return;
+        for (const QString &f : transformer->importedFilesUsedInPrepareScript)
+            importedFiles.insert(f);
+        for (const QString &f : transformer->importedFilesUsedInCommands)
+            importedFiles.insert(f);
+        for (const AbstractCommandPtr &c : transformer->commands.commands()) {
+            if (c->type() != AbstractCommand::ProcessCommandType)
+                continue;
+            const auto envVars = static_cast<const ProcessCommand *>(c.get())->relevantEnvVars();
+            for (const QString &var : envVars)
+                relevantEnvValues.insert(var, product->buildEnvironment.value(var));
+        }
+    }
+    for (const ResolvedProductPtr &dependency : product->dependencies)
+        otherProducts.remove(dependency->uniqueName());
+    state.valid = true;
+    state.buildTime = m_buildStartTime;
+    state.otherProducts.assign(otherProducts.cbegin(), otherProducts.cend());
+    state.importedFiles.assign(importedFiles.cbegin(), importedFiles.cend());
+    for (auto it = relevantEnvValues.cbegin(); it != relevantEnvValues.cend(); ++it)
+        state.relevantEnvValues.emplace_back(it.key(), it.value());
+    product->buildData->setUpToDateState(state);
+    m_project->buildData->setDirty();
+}
+
 /**
   * Sets the state of all artifacts in the graph to "untouched".
   * This must be done before doing a build.
@@ -1197,31 +1541,103 @@ bool Executor::visit(RuleNode *ruleNode)
   */
 void Executor::prepareAllNodes()
 {
-    for (const ResolvedProductPtr &product : m_allProducts) {
-        if (product->enabled) {
-            QBS_CHECK(product->buildData);
-            for (BuildGraphNode * const node : qAsConst(product->buildData->allNodes()))
-                node->buildState = BuildGraphNode::Untouched;
+    // If the stored timestamps can be trusted, we know which source files have changed
+    // without looking at the products' artifacts, so the unchanged products can be
+    // determined up front and their source files are neither collected nor stat()ed.
+    const bool skipBeforeCollectingSources = m_useChangedFiles;
+    if (skipBeforeCollectingSources) {
+        for (const QString &filePath : qAsConst(m_changedFiles)) {
+            for (const FileResourceBase * const f : m_project->buildData->lookupFiles(filePath)) {
+                if (f->fileType() != FileResourceBase::FileTypeArtifact)
+                    continue;
+                const auto artifact = static_cast<const Artifact *>(f);
+                if (artifact->artifactType == Artifact::SourceFile)
+                    m_productsWithChangedSources.insert(artifact->product.get());
+            }
         }
+        skipUnchangedProducts();
     }
+
+    std::vector<Artifact *> sourceArtifacts;
     for (const ResolvedProductPtr &product : qAsConst(m_productsToBuild)) {
         QBS_CHECK(product->buildData);
-        for (Artifact * const artifact : filterByType<Artifact>(product->buildData->allNodes()))
-            prepareArtifact(artifact);
+        if (m_skippedProducts.contains(product.get()))
+            continue;
+        for (Artifact * const artifact : filterByType<Artifact>(product->buildData->allNodes())) {
+            artifact->inputsScanned = false;
+            artifact->timestampRetrieved = false;
+            if (artifact->artifactType == Artifact::SourceFile)
+                sourceArtifacts.push_back(artifact);
+        }
     }
+    retrieveSourceFileTimestamps(sourceArtifacts);
+    if (!skipBeforeCollectingSources)
+        skipUnchangedProducts();
+
+    // The nodes of skipped products are still referenced from other products, so they
+    // need a valid state. This is the only time they are touched.
+    for (const ResolvedProductPtr &product : m_allProducts) {
+        if (!product->enabled)
+            continue;
+        QBS_CHECK(product->buildData);
+        const BuildGraphNode::BuildState state = m_skippedProducts.contains(product.get())
+                ? BuildGraphNode::Built : BuildGraphNode::Untouched;
+        for (BuildGraphNode * const node : qAsConst(product->buildData->allNodes()))
+            node->buildState = state;
+    }
+    for (const Artifact * const artifact : sourceArtifacts)
+        possiblyInstallArtifact(artifact);
 }
 
 void Executor::syncFileDependencies()
 {
     Set<FileDependency *> &globalFileDepList = m_project->buildData->fileDependencies;
-    for (auto it = globalFileDepList.begin(); it != globalFileDepList.end(); ) {
-        FileDependency * const dep = *it;
-        FileInfo fi(dep->filePath());
-        if (fi.exists()) {
-            dep->setTimestamp(fi.lastModified());
-            ++it;
-            continue;
+
+    // If we know exactly which files have changed, the stored timestamps of all other
+    // file dependencies are still accurate.
+    std::vector<std::pair<FileDependency *, FileTime>> timestamps;
+    for (FileDependency * const dep : globalFileDepList) {
+        if (!m_buildOptions.changedFilesComplete() || !dep->timestamp().isValid()
+                || m_changedFiles.contains(dep->filePath())) {
+            timestamps.emplace_back(dep, FileTime());
+        }
+    }
+    parallelForEach(timestamps, [](std::pair<FileDependency *, FileTime> &depAndTimestamp) {
+        const FileInfo fi(depAndTimestamp.first->filePath());
+        if (fi.exists())
+            depAndTimestamp.second = fi.lastModified();
+    }, m_buildOptions.maxJobCount());
+
+    Set<FileDependency *> changedDeps;
+    std::vector<FileDependency *> vanishedDeps;
+    for (const auto &depAndTimestamp : timestamps) {
+        FileDependency * const dep = depAndTimestamp.first;
+        if (!depAndTimestamp.second.isValid()) {
+            changedDeps.insert(dep);
+            vanishedDeps.push_back(dep);
+        } else if (dep->timestamp() != depAndTimestamp.second) {
+            dep->setTimestamp(depAndTimestamp.second);
+            changedDeps.insert(dep);
+        }
+    }
+
+    // Only the products with artifacts that depend on a changed file must not be skipped.
+    // Products depending on them are taken care of by skipUnchangedProducts().
+    if (!changedDeps.empty()) {
+        for (const ResolvedProductPtr &product : m_allProducts) {
+            if (!product->buildData)
+                continue;
+            const auto artifacts = filterByType<Artifact>(product->buildData->allNodes());
+            for (const Artifact * const artifact : artifacts) {
+                if (artifact->fileDependencies.intersects(changedDeps)) {
+                    m_productsWithChangedSources.insert(product.get());
+                    break;
+                }
+            }
         }
+    }
+
+    for (FileDependency * const dep : vanishedDeps) {
         qCDebug(lcBuildGraph()) << "file dependency" << dep->filePath() << "no longer exists; "
                                    "removing from lookup table";
         m_project->buildData->removeFromLookupTable(dep);
@@ -1240,26 +1656,14 @@ void Executor::syncFileDependencies()
         }
         if (!isReferencedByArtifact) {
             qCDebug(lcBuildGraph()) << "dependency is not referenced by any artifact, deleting";
-            it = globalFileDepList.erase(it);
+            globalFileDepList.remove(dep);
             delete dep;
         } else {
             dep->clearTimestamp();
-            ++it;
         }
     }
 }
 
-void Executor::prepareArtifact(Artifact *artifact)
-{
-    artifact->inputsScanned = false;
-    artifact->timestampRetrieved = false;
-
-    if (artifact->artifactType == Artifact::SourceFile) {
-        retrieveSourceFileTimestamp(artifact);
-        possiblyInstallArtifact(artifact);
-    }
-}
-
 void Executor::setupForBuildingSelectedFiles(const BuildGraphNode *node)
 {
     if (node->type() != BuildGraphNode::RuleNodeType)
@@ -1317,8 +1721,10 @@ void Executor::prepareProducts()
 void Executor::setupRootNodes()
 {
     m_roots.clear();
-    for (const ResolvedProductPtr &product : qAsConst(m_productsToBuild))
-        m_roots += product->buildData->rootNodes();
+    for (const ResolvedProductPtr &product : qAsConst(m_productsToBuild)) {
+        if (!m_skippedProducts.contains(product.get()))
+            m_roots += product->buildData->rootNodes();
+    }
 }
 
 void Executor::setState(ExecutorState s)
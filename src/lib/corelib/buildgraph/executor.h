@@ -48,16 +48,18 @@
 #include <logging/logger.h>
 #include <tools/buildoptions.h>
 #include <tools/error.h>
+#include <tools/filetime.h>
 #include <tools/qttools.h>
+#include <tools/systemresources.h>
 
+#include <QtCore/qelapsedtimer.h>
 #include <QtCore/qobject.h>
 
+#include <deque>
 #include <queue>
 #include <unordered_map>
-
-QT_BEGIN_NAMESPACE
-class QTimer;
-QT_END_NAMESPACE
+#include <utility>
+#include <vector>
 
 namespace qbs {
 class ProcessResult;
@@ -87,6 +89,9 @@ public:
 
     ErrorInfo error() const { return m_error; }
 
+    // To be called when the progress observer's cancel flag has been set.
+    void checkForCancellation();
+
 signals:
     void reportCommandDescription(const QString &highlight, const QString &message);
     void reportProcessResult(const qbs::ProcessResult &result);
@@ -96,7 +101,6 @@ signals:
 private:
     void onJobFinished(const qbs::ErrorInfo &err);
     void finish();
-    void checkForCancellation();
 
     // BuildGraphVisitor implementation
     bool visit(Artifact *artifact) override;
@@ -114,8 +118,12 @@ private:
 
     void doBuild();
     void prepareAllNodes();
+    bool productSkippingAllowed() const;
+    bool isProductUnchanged(const ResolvedProduct *product,
+                            std::unordered_map<const ResolvedProduct *, bool> &cache);
+    void skipUnchangedProducts();
+    void recordUpToDateState(const ResolvedProduct *product);
     void syncFileDependencies();
-    void prepareArtifact(Artifact *artifact);
     void setupForBuildingSelectedFiles(const BuildGraphNode *node);
     void prepareReachableNodes();
     void prepareReachableNodes_impl(BuildGraphNode *node);
@@ -131,6 +139,7 @@ private:
     void finishNode(BuildGraphNode *leaf);
     void finishArtifact(Artifact *artifact);
     void setState(ExecutorState);
+    void startWaitingTransformers();
     void addExecutorJobs();
     void cancelJobs();
     void setupProgressObserver();
@@ -140,6 +149,7 @@ private:
     bool checkForUnbuiltDependencies(Artifact *artifact);
     void potentiallyRunTransformer(const TransformerPtr &transformer);
     void runTransformer(const TransformerPtr &transformer);
+    void startTransformer(const TransformerPtr &transformer);
     void finishTransformer(const TransformerPtr &transformer);
     void possiblyInstallArtifact(const Artifact *artifact);
     void checkForUnbuiltProducts();
@@ -147,8 +157,11 @@ private:
 
     bool mustExecuteTransformer(const TransformerPtr &transformer) const;
     bool isUpToDate(Artifact *artifact) const;
+    bool mustRetrieveSourceFileTimestamp(const Artifact *artifact) const;
     void retrieveSourceFileTimestamp(Artifact *artifact) const;
-    FileTime recursiveFileTime(const QString &filePath) const;
+    void retrieveSourceFileTimestamps(const std::vector<Artifact *> &artifacts);
+    void markSourceFileChanged(Artifact *artifact, const FileTime &timestamp);
+    void finishSourceFileTimestampRetrieval(Artifact *artifact) const;
     QString configString() const;
     bool transformerHasMatchingOutputTags(const TransformerConstPtr &transformer) const;
     bool artifactHasMatchingOutputTags(const Artifact *artifact) const;
@@ -157,9 +170,13 @@ private:
     void setupJobLimits();
     void updateJobCounts(const Transformer *transformer, int diff);
     bool schedulingBlockedByJobLimit(const BuildGraphNode *node);
+    bool schedulingBlockedBySystemResources(const BuildGraphNode *node);
+    qint64 expectedMemoryUsage(const Transformer *transformer) const;
+    void recordMemoryUsage(const ExecutorJob *job, const Transformer *transformer);
 
     using JobMap = QHash<ExecutorJob *, TransformerPtr>;
     JobMap m_processingJobs;
+    std::deque<TransformerPtr> m_transformersWaitingForToken;
 
     ProductInstaller *m_productInstaller;
     RulesEvaluationContextPtr m_evalContext;
@@ -173,8 +190,12 @@ private:
     QVector<ResolvedProductPtr> m_productsToBuild;
     std::vector<ResolvedProductPtr> m_allProducts;
     std::unordered_map<QString, const ResolvedProduct *> m_productsByName;
+    std::unordered_map<QString, const ResolvedProduct *> m_allProductsByName;
     std::unordered_map<QString, const ResolvedProject *> m_projectsByName;
     std::unordered_map<QString, int> m_jobCountPerPool;
+    std::vector<std::pair<TransformerPtr, qint64>> m_measuredDurations;
+    SystemResources m_systemResources;
+    QElapsedTimer m_systemResourcesTimer;
     std::unordered_map<const ResolvedProduct *, JobLimits> m_jobLimitsPerProduct;
     std::unordered_map<const Rule *, int> m_pendingTransformersPerRule;
     NodeSet m_roots;
@@ -182,12 +203,19 @@ private:
     InputArtifactScannerContext *m_inputArtifactScanContext;
     ErrorInfo m_error;
     bool m_explicitlyCanceled = false;
+    bool m_registeredWithJobServer = false;
+    bool m_jobTokenPollPending = false;
     FileTags m_activeFileTags;
     FileTags m_tagsOfFilesToConsider;
     FileTags m_tagsNeededForFilesToConsider;
     QList<ResolvedProductPtr> m_productsOfFilesToConsider;
-    QTimer * const m_cancelationTimer;
     QStringList m_artifactsRemovedFromDisk;
+    Set<QString> m_changedFiles;
+    bool m_useChangedFiles = false;
+    Set<const ResolvedProduct *> m_productsWithChangedSources;
+    Set<const ResolvedProduct *> m_skippedProducts;
+    std::unordered_map<QString, FileTime> m_importedFileTimes;
+    FileTime m_buildStartTime;
     bool m_partialBuild = false;
     qint64 m_elapsedTimeRules = 0;
     qint64 m_elapsedTimeScanners = 0;
@@ -50,6 +50,8 @@
 
 #include <QtCore/qthread.h>
 
+#include <algorithm>
+
 namespace qbs {
 namespace Internal {
 
@@ -91,10 +93,17 @@ void ExecutorJob::setEchoMode(CommandEchoMode echoMode)
     m_jsCommandExecutor->setEchoMode(echoMode);
 }
 
+void ExecutorJob::setTrackMemoryUsage(bool track)
+{
+    m_processCommandExecutor->setTrackMemoryUsage(track);
+}
+
 void ExecutorJob::run(Transformer *t)
 {
     QBS_ASSERT(m_currentCommandIdx == -1, return);
 
+    m_peakMemoryUsage = -1;
+    m_timer.start();
     if (t->commands.empty()) {
         setFinished();
         return;
@@ -150,6 +159,10 @@ void ExecutorJob::runNextCommand()
 void ExecutorJob::onCommandFinished(const ErrorInfo &err)
 {
     QBS_ASSERT(m_transformer, return);
+    if (m_currentCommandExecutor == m_processCommandExecutor) {
+        m_peakMemoryUsage = std::max(m_peakMemoryUsage,
+                                     m_processCommandExecutor->peakMemoryUsage());
+    }
     if (m_error.hasError()) { // Canceled?
         setFinished();
     } else if (err.hasError()) {
@@ -162,6 +175,7 @@ void ExecutorJob::onCommandFinished(const ErrorInfo &err)
 
 void ExecutorJob::setFinished()
 {
+    m_elapsedTime = m_timer.elapsed();
     const ErrorInfo err = m_error;
     reset();
     emit finished(err);
@@ -45,6 +45,7 @@
 #include <tools/error.h>
 #include <tools/set.h>
 
+#include <QtCore/qelapsedtimer.h>
 #include <QtCore/qobject.h>
 #include <QtCore/qstring.h>
 
@@ -71,11 +72,18 @@ public:
     void setMainThreadScriptEngine(ScriptEngine *engine);
     void setDryRun(bool enabled);
     void setEchoMode(CommandEchoMode echoMode);
+    void setTrackMemoryUsage(bool track);
     void run(Transformer *t);
     void cancel();
     const Transformer *transformer() const { return m_transformer; }
     Set<QString> jobPools() const { return m_jobPools; }
 
+    // The highest memory usage of the commands of the last transformer, or -1 if unknown.
+    qint64 peakMemoryUsage() const { return m_peakMemoryUsage; }
+
+    // The time in ms it took to run the commands of the last transformer.
+    qint64 elapsedTime() const { return m_elapsedTime; }
+
 signals:
     void reportCommandDescription(const QString &highlight, const QString &message);
     void reportProcessResult(const qbs::ProcessResult &result);
@@ -94,6 +102,9 @@ private:
     Transformer *m_transformer = nullptr;
     Set<QString> m_jobPools;
     int m_currentCommandIdx = 0;
+    qint64 m_peakMemoryUsage = -1;
+    QElapsedTimer m_timer;
+    qint64 m_elapsedTime = -1;
     ErrorInfo m_error;
 };
 
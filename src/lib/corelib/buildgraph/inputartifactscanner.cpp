@@ -177,30 +177,81 @@ void InputArtifactScanner::scanForFileDependencies(Artifact *inputArtifact)
     InputArtifactScannerContext::CacheItem *lastPerFileCacheItem = nullptr;
     InputArtifactScannerContext::CacheItem *lastPerPropsCacheItem = nullptr;
     while (!filesToScan.empty()) {
-        FileResourceBase *fileToBeScanned = filesToScan.takeFirst();
-        const QString &filePathToBeScanned = fileToBeScanned->filePath();
-        if (!visitedFilePaths.insert(filePathToBeScanned).second)
-            continue;
+        // Files are processed breadth-first, one level of the include tree at a time,
+        // so that the raw scanning of all files in a level can be done in one batch.
+        QList<FileResourceBase *> currentLevel;
+        for (FileResourceBase * const file : qAsConst(filesToScan)) {
+            if (visitedFilePaths.insert(file->filePath()).second)
+                currentLevel.push_back(file);
+        }
+        filesToScan.clear();
 
         for (DependencyScanner * const scanner : scanners) {
-            InputArtifactScannerContext::CacheItem *cacheItem;
-            if (scanner->cacheIsPerFile()) {
-                if (!lastPerFileCacheItem)
-                    lastPerFileCacheItem = &m_context->cachePerFile[inputArtifact];
-                cacheItem = lastPerFileCacheItem;
-            } else {
-                if (!lastPerPropsCacheItem) {
-                    lastPerPropsCacheItem = &m_context->cachePerProperties
-                            [inputArtifact->properties];
+            if (scanner->supportsBatchScanning())
+                scanOutdatedFiles(scanner, inputArtifact, currentLevel);
+        }
+
+        for (FileResourceBase * const fileToBeScanned : qAsConst(currentLevel)) {
+            for (DependencyScanner * const scanner : scanners) {
+                InputArtifactScannerContext::CacheItem *cacheItem;
+                if (scanner->cacheIsPerFile()) {
+                    if (!lastPerFileCacheItem)
+                        lastPerFileCacheItem = &m_context->cachePerFile[inputArtifact];
+                    cacheItem = lastPerFileCacheItem;
+                } else {
+                    if (!lastPerPropsCacheItem) {
+                        lastPerPropsCacheItem = &m_context->cachePerProperties
+                                [inputArtifact->properties];
+                    }
+                    cacheItem = lastPerPropsCacheItem;
                 }
-                cacheItem = lastPerPropsCacheItem;
+                scanForScannerFileDependencies(scanner, inputArtifact, fileToBeScanned,
+                    scanner->recursive() ? &filesToScan : nullptr,
+                    (*cacheItem)[scanner->key()]);
             }
-            scanForScannerFileDependencies(scanner, inputArtifact, fileToBeScanned,
-                scanner->recursive() ? &filesToScan : nullptr, (*cacheItem)[scanner->key()]);
         }
     }
 }
 
+// Brings the raw scan results of all the given files up to date with a single batch call.
+// scanForScannerFileDependencies() will then find them current and only resolve them.
+void InputArtifactScanner::scanOutdatedFiles(DependencyScanner *scanner, Artifact *inputArtifact,
+                                             const QList<FileResourceBase *> &files)
+{
+    std::vector<FileResourceBase *> outdatedFiles;
+    std::vector<RawScanResults::ScanData *> outdatedScanData;
+    for (FileResourceBase * const file : files) {
+        RawScanResults::ScanData &scanData = m_rawScanResults.findScanData(
+                    file, scanner, m_artifact->properties);
+        if (scanData.lastScanTime < file->timestamp()) {
+            outdatedFiles.push_back(file);
+            outdatedScanData.push_back(&scanData);
+        }
+    }
+    if (outdatedFiles.size() < 2)
+        return;
+
+    qCDebug(lcDepScan) << "scanning" << outdatedFiles.size() << "files in one batch";
+    const std::vector<std::optional<QStringList>> dependencies
+            = scanner->collectDependenciesOfFiles(inputArtifact, outdatedFiles,
+                                                  m_fileTagsForScanner.constData());
+    QBS_CHECK(dependencies.size() == outdatedFiles.size());
+    const FileTime scanTime = FileTime::currentTime();
+    for (size_t i = 0; i < outdatedFiles.size(); ++i) {
+        // A file that failed to scan stays outdated, so that it gets scanned on its own
+        // later, with the usual error handling.
+        if (!dependencies.at(i)) {
+            qCDebug(lcDepScan) << "batch scan failed for" << outdatedFiles.at(i)->filePath();
+            continue;
+        }
+        RawScanResults::ScanData * const scanData = outdatedScanData.at(i);
+        scanData->rawScanResult.deps.clear();
+        for (const QString &s : *dependencies.at(i))
+            scanData->rawScanResult.deps.emplace_back(s);
+        scanData->lastScanTime = scanTime;
+    }
+}
+
 Set<DependencyScanner *> InputArtifactScanner::scannersForArtifact(const Artifact *artifact) const
 {
     Set<DependencyScanner *> scanners;
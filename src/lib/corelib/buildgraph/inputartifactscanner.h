@@ -125,6 +125,8 @@ public:
 private:
     void scanForFileDependencies(Artifact *inputArtifact);
     Set<DependencyScanner *> scannersForArtifact(const Artifact *artifact) const;
+    void scanOutdatedFiles(DependencyScanner *scanner, Artifact *inputArtifact,
+                           const QList<FileResourceBase *> &files);
     void scanForScannerFileDependencies(DependencyScanner *scanner,
             Artifact *inputArtifact, FileResourceBase *fileToBeScanned,
             QList<FileResourceBase *> *filesToScan,
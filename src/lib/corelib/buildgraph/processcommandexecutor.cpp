@@ -54,6 +54,7 @@
 #include <tools/executablefinder.h>
 #include <tools/fileinfo.h>
 #include <tools/hostosinfo.h>
+#include <tools/jobserver.h>
 #include <tools/processresult.h>
 #include <tools/processresult_p.h>
 #include <tools/qbsassert.h>
@@ -115,6 +116,9 @@ void ProcessCommandExecutor::doSetup()
         cmd->addRelevantEnvValue(key, transformer()->product()->buildEnvironment.value(key));
 
     m_commandEnvironment = mergeEnvironments(m_buildEnvironment, cmd->environment());
+    const QString makeFlags = JobServer::instance().makeFlags();
+    if (!makeFlags.isEmpty() && !cmd->environment().contains(QStringLiteral("MAKEFLAGS")))
+        m_commandEnvironment.insert(QStringLiteral("MAKEFLAGS"), makeFlags);
     m_program = program;
     m_arguments = cmd->arguments();
     m_shellInvocation = shellQuote(QDir::toNativeSeparators(m_program), m_arguments);
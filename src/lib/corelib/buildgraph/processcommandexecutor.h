@@ -62,6 +62,8 @@ public:
     void setProcessEnvironment(const QProcessEnvironment &processEnvironment) {
         m_buildEnvironment = processEnvironment;
     }
+    void setTrackMemoryUsage(bool track) { m_process.setTrackMemoryUsage(track); }
+    qint64 peakMemoryUsage() const { return m_process.peakMemoryUsage(); }
 
 signals:
     void reportProcessResult(const qbs::ProcessResult &result);
@@ -59,9 +59,16 @@ const TypeFilter<Artifact> ProductBuildData::rootArtifacts() const
     return TypeFilter<Artifact>(m_roots);
 }
 
+void ProductBuildData::addNode(BuildGraphNode *node)
+{
+    m_nodes.insert(node);
+    invalidateUpToDateState();
+}
+
 void ProductBuildData::addArtifact(Artifact *artifact)
 {
     QBS_CHECK(m_nodes.insert(artifact).second);
+    invalidateUpToDateState();
     addArtifactToSet(artifact);
 }
 
@@ -79,6 +86,7 @@ void ProductBuildData::removeArtifact(Artifact *artifact)
     m_roots.remove(artifact);
     m_nodes.remove(artifact);
     removeArtifactFromSet(artifact);
+    invalidateUpToDateState();
 }
 
 void ProductBuildData::removeArtifactFromSetByFileTag(Artifact *artifact, const FileTag &fileTag)
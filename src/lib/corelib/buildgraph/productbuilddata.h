@@ -44,6 +44,7 @@
 #include "rescuableartifactdata.h"
 #include <language/filetags.h>
 #include <language/forward_decls.h>
+#include <tools/filetime.h>
 #include <tools/persistence.h>
 
 #include <QtCore/qlist.h>
@@ -57,6 +58,25 @@ class Logger;
 
 using ArtifactSetByFileTag = QHash<FileTag, ArtifactSet>;
 
+// Recorded after a build in which all of a product's nodes were built. As long as none of
+// the inputs listed here has changed, the product does not have to be looked at in the next
+// build. The declared product dependencies are not listed, as they are known anyway.
+class ProductUpToDateState
+{
+public:
+    bool valid = false;
+    FileTime buildTime;
+    std::vector<QString> otherProducts;
+    std::vector<QString> importedFiles;
+    std::vector<std::pair<QString, QString>> relevantEnvValues;
+
+    template<PersistentPool::OpType opType> void completeSerializationOp(PersistentPool &pool)
+    {
+        pool.serializationOp<opType>(valid, buildTime, otherProducts, importedFiles,
+                                     relevantEnvValues);
+    }
+};
+
 class QBS_AUTOTEST_EXPORT ProductBuildData
 {
 public:
@@ -66,7 +86,7 @@ public:
     const NodeSet &allNodes() const { return m_nodes; }
     const NodeSet &rootNodes() const { return m_roots; }
 
-    void addNode(BuildGraphNode *node) { m_nodes.insert(node); }
+    void addNode(BuildGraphNode *node);
     void addRootNode(BuildGraphNode *node) { m_roots.insert(node); }
     void removeFromRootNodes(BuildGraphNode *node) { m_roots.remove(node); }
     void addArtifact(Artifact *artifact);
@@ -78,6 +98,10 @@ public:
     ArtifactSetByFileTag artifactsByFileTag() const;
 
     AllRescuableArtifactData rescuableArtifactData() const { return m_rescuableArtifactData; }
+    RescuableArtifactData rescuableArtifactData(const QString &filePath) const
+    {
+        return m_rescuableArtifactData.value(filePath);
+    }
     void setRescuableArtifactData(const AllRescuableArtifactData &rad);
     RescuableArtifactData removeFromRescuableArtifactData(const QString &filePath);
     void addRescuableArtifactData(const QString &filePath, const RescuableArtifactData &rad);
@@ -87,10 +111,14 @@ public:
 
     bool checkAndSetJsArtifactsMapUpToDateFlag();
 
+    const ProductUpToDateState &upToDateState() const { return m_upToDateState; }
+    void setUpToDateState(const ProductUpToDateState &state) { m_upToDateState = state; }
+    void invalidateUpToDateState() { m_upToDateState = ProductUpToDateState(); }
+
     template<PersistentPool::OpType opType> void completeSerializationOp(PersistentPool &pool)
     {
         pool.serializationOp<opType>(m_nodes, m_roots, m_rescuableArtifactData,
-                                     m_artifactsByFileTag);
+                                     m_artifactsByFileTag, m_upToDateState);
     }
 
 private:
@@ -112,6 +140,8 @@ private:
     mutable std::mutex m_artifactsMapMutex;
 
     bool m_jsArtifactsMapUpToDate = true;
+
+    ProductUpToDateState m_upToDateState;
 };
 
 } // namespace Internal
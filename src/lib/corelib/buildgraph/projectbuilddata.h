@@ -89,6 +89,9 @@ public:
     Set<FileDependency *> fileDependencies;
     RawScanResults rawScanResults;
 
+    // Highest memory usage observed for commands of a job pool, in bytes.
+    std::unordered_map<QString, qint64> peakMemoryUsagePerJobPool;
+
     // do not serialize:
     RulesEvaluationContextPtr evaluationContext;
 
@@ -98,7 +101,8 @@ public:
 private:
     template<PersistentPool::OpType opType> void serializationOp(PersistentPool &pool)
     {
-        pool.serializationOp<opType>(fileDependencies, rawScanResults);
+        pool.serializationOp<opType>(fileDependencies, rawScanResults,
+                                     peakMemoryUsagePerJobPool);
     }
 
     using ArtifactKey = std::pair<QString /*fileName*/, QString /*dirName*/>;
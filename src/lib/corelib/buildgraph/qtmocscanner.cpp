@@ -64,6 +64,7 @@ struct CommonFileTags
 {
     const FileTag cpp = "cpp";
     const FileTag cppCombine = "cpp.combine";
+    const FileTag cppUnity = "cpp.unity";
     const FileTag hpp = "hpp";
     const FileTag moc_cpp = "moc_cpp";
     const FileTag moc_cpp_plugin = "moc_cpp_plugin";
@@ -75,31 +76,6 @@ struct CommonFileTags
 
 Q_GLOBAL_STATIC(CommonFileTags, commonFileTags)
 
-class QtScanner : public DependencyScanner
-{
-public:
-    QtScanner(const DependencyScanner &actualScanner)
-        : m_id(QStringLiteral("qt") + actualScanner.id()) {}
-
-private:
-    QStringList collectSearchPaths(Artifact *) override { return {}; }
-    QStringList collectDependencies(Artifact *, FileResourceBase *, const char *) override
-    {
-        return {};
-    }
-    bool recursive() const override { return false; }
-    const void *key() const override { return nullptr; }
-    QString createId() const override { return m_id; }
-    bool areModulePropertiesCompatible(const PropertyMapConstPtr &,
-                                       const PropertyMapConstPtr &) const override
-    {
-        return true;
-    }
-    bool cacheIsPerFile() const override { return false; }
-
-    const QString m_id;
-};
-
 static QString qtMocScannerJsName() { return QStringLiteral("QtMocScanner"); }
 
 QtMocScanner::QtMocScanner(const ResolvedProductPtr &product, QScriptValue targetScriptValue)
@@ -119,63 +95,6 @@ QtMocScanner::~QtMocScanner()
     m_targetScriptValue.setProperty(qtMocScannerJsName(), QScriptValue());
 }
 
-static RawScanResult runScanner(ScannerPlugin *scanner, const Artifact *artifact)
-{
-    const QString &filepath = artifact->filePath();
-    QtScanner depScanner((PluginDependencyScanner(scanner)));
-    RawScanResults &rawScanResults
-            = artifact->product->topLevelProject()->buildData->rawScanResults;
-    RawScanResults::ScanData &scanData = rawScanResults.findScanData(artifact, &depScanner,
-                                                                     artifact->properties);
-    if (scanData.lastScanTime < artifact->timestamp()) {
-        FileTags tags = artifact->fileTags();
-        if (tags.contains(commonFileTags->cppCombine)) {
-            tags.remove(commonFileTags->cppCombine);
-            tags.insert(commonFileTags->cpp);
-        }
-        if (tags.contains(commonFileTags->objcppCombine)) {
-            tags.remove(commonFileTags->objcppCombine);
-            tags.insert(commonFileTags->objcpp);
-        }
-        const QByteArray tagsForScanner = tags.toStringList().join(QLatin1Char(',')).toLatin1();
-        void *opaq = scanner->open(filepath.utf16(), tagsForScanner.constData(),
-                                   ScanForDependenciesFlag | ScanForFileTagsFlag);
-        if (!opaq || !scanner->additionalFileTags)
-            return scanData.rawScanResult;
-
-        scanData.rawScanResult.additionalFileTags.clear();
-        scanData.rawScanResult.deps.clear();
-        int length = 0;
-        const char **szFileTagsFromScanner = scanner->additionalFileTags(opaq, &length);
-        if (szFileTagsFromScanner) {
-            for (int i = length; --i >= 0;)
-                scanData.rawScanResult.additionalFileTags += szFileTagsFromScanner[i];
-        }
-
-        QString baseDirOfInFilePath = artifact->dirPath();
-        forever {
-            int flags = 0;
-            const char *szOutFilePath = scanner->next(opaq, &length, &flags);
-            if (szOutFilePath == nullptr)
-                break;
-            QString includedFilePath = QString::fromLocal8Bit(szOutFilePath, length);
-            if (includedFilePath.isEmpty())
-                continue;
-            bool isLocalInclude = (flags & SC_LOCAL_INCLUDE_FLAG);
-            if (isLocalInclude) {
-                QString localFilePath = FileInfo::resolvePath(baseDirOfInFilePath, includedFilePath);
-                if (FileInfo::exists(localFilePath))
-                    includedFilePath = localFilePath;
-            }
-            scanData.rawScanResult.deps.emplace_back(includedFilePath);
-        }
-
-        scanner->close(opaq);
-        scanData.lastScanTime = FileTime::currentTime();
-    }
-    return scanData.rawScanResult;
-}
-
 void QtMocScanner::findIncludedMocCppFiles()
 {
     if (!m_includedMocCppFiles.empty())
@@ -183,18 +102,14 @@ void QtMocScanner::findIncludedMocCppFiles()
 
     qCDebug(lcMocScan) << "looking for included moc_XXX.cpp files";
 
-    static const FileTags mocCppTags = {m_tags.cpp, m_tags.objcpp};
+    static const FileTags mocCppTags = {m_tags.cpp, m_tags.cppUnity, m_tags.objcpp};
     for (Artifact *artifact : m_product->lookupArtifactsByFileTags(mocCppTags)) {
-        const RawScanResult scanResult = runScanner(m_cppScanner, artifact);
-        for (const RawScannedDependency &dependency : scanResult.deps) {
-            QString includedFileName = dependency.fileName();
-            if (includedFileName.startsWith(QLatin1String("moc_"))
-                    && includedFileName.endsWith(QLatin1String(".cpp"))) {
-                qCDebug(lcMocScan) << artifact->fileName() << "includes" << includedFileName;
-                includedFileName.remove(0, 4);
-                includedFileName.chop(4);
-                m_includedMocCppFiles.insert(includedFileName, artifact->fileName());
-            }
+        const CppScanResult scanResult = scanCppFile(m_cppScanner, artifact);
+        for (const QString &includedFileName : scanResult.includedMocCppFiles) {
+            qCDebug(lcMocScan) << artifact->fileName() << "includes"
+                               << (QLatin1String("moc_") + includedFileName
+                                   + QLatin1String(".cpp"));
+            m_includedMocCppFiles.insert(includedFileName, artifact->fileName());
         }
     }
 }
@@ -230,12 +145,13 @@ QScriptValue QtMocScanner::apply(QScriptEngine *engine, const Artifact *artifact
     bool hasPluginMetaDataMacro = false;
     const bool isHeaderFile = artifact->fileTags().contains(m_tags.hpp);
 
-    RawScanResult scanResult = runScanner(m_cppScanner, artifact);
+    CppScanResult scanResult = scanCppFile(m_cppScanner, artifact);
     if (scanResult.additionalFileTags.empty() && artifact->fileTags().contains("mocable")) {
         if (isHeaderFile) {
             scanResult.additionalFileTags.insert(m_tags.moc_hpp);
         } else if (artifact->fileTags().contains(m_tags.cpp)
                    || artifact->fileTags().contains(m_tags.cppCombine)
+                   || artifact->fileTags().contains(m_tags.cppUnity)
                    || artifact->fileTags().contains(m_tags.objcpp)
                    || artifact->fileTags().contains(m_tags.objcppCombine)) {
             scanResult.additionalFileTags.insert(m_tags.moc_cpp);
@@ -52,8 +52,13 @@ RawScanResults::ScanData &RawScanResults::findScanData(
         const DependencyScanner *scanner,
         const PropertyMapConstPtr &moduleProperties)
 {
-    std::vector<ScanData> &scanDataForFile = m_rawScanData[file->filePath()];
     const QString &scannerId = scanner->id();
+    // qHash() with an explicit seed is stable across processes, which the key must be,
+    // as it is stored in the build graph.
+    const quint64 fingerprint = scanner->propertiesFingerprint(moduleProperties);
+    const quint64 key = fingerprint ^ (quint64(qHash(scannerId, 0)) + 0x9e3779b97f4a7c15ULL
+                                       + (fingerprint << 6) + (fingerprint >> 2));
+    std::vector<ScanData> &scanDataForFile = m_rawScanData[file->filePath()][key];
     for (auto &scanData : scanDataForFile) {
         if (scannerId != scanData.scannerId)
             continue;
@@ -68,5 +73,10 @@ RawScanResults::ScanData &RawScanResults::findScanData(
     return scanDataForFile.back();
 }
 
+CppScanResult &RawScanResults::findCppScanResult(const FileResourceBase *file)
+{
+    return m_cppScanResults[file->filePath()];
+}
+
 } // namespace Internal
 } // namespace qbs
@@ -50,7 +50,9 @@
 
 #include <QtCore/qhash.h>
 #include <QtCore/qstring.h>
+#include <QtCore/qstringlist.h>
 
+#include <unordered_map>
 #include <vector>
 
 namespace qbs {
@@ -70,6 +72,28 @@ public:
     }
 };
 
+// The parts of a scan of a C++ file that the QtMocScanner and the AutoPchScanner need.
+// They are much smaller than the full scan result, and they do not require resolving
+// the included files.
+class CppScanResult
+{
+public:
+    FileTime lastScanTime;
+    FileTags additionalFileTags;
+
+    // Complete base names of included moc files, e.g. "foo" for "moc_foo.cpp".
+    QStringList includedMocCppFiles;
+
+    // Files included via angle brackets, as written in the source, e.g. "QtCore/qstring.h".
+    QStringList systemIncludes;
+
+    template<PersistentPool::OpType opType> void completeSerializationOp(PersistentPool &pool)
+    {
+        pool.serializationOp<opType>(lastScanTime, additionalFileTags, includedMocCppFiles,
+                                     systemIncludes);
+    }
+};
+
 class RawScanResults
 {
 public:
@@ -91,13 +115,20 @@ public:
             const DependencyScanner *scanner,
             const PropertyMapConstPtr &moduleProperties);
 
+    CppScanResult &findCppScanResult(const FileResourceBase *file);
+
     template<PersistentPool::OpType opType> void completeSerializationOp(PersistentPool &pool)
     {
-        pool.serializationOp<opType>(m_rawScanData);
+        pool.serializationOp<opType>(m_rawScanData, m_cppScanResults);
     }
 
 private:
-    QHash<QString, std::vector<ScanData>> m_rawScanData;
+    // Per file path, the scan data is indexed by a combination of the scanner id and the
+    // scanner's fingerprint of the module properties. Entries sharing a key are either
+    // hash collisions or properties the scanner considers incompatible despite their
+    // fingerprints being equal.
+    QHash<QString, std::unordered_map<quint64, std::vector<ScanData>>> m_rawScanData;
+    QHash<QString, CppScanResult> m_cppScanResults;
 };
 
 } // namespace Internal
@@ -77,7 +77,8 @@ public:
                                      exportedModulesAccessedInPrepareScript,
                                      exportedModulesAccessedInCommands,
                                      lastPrepareScriptExecutionTime,
-                                     lastCommandExecutionTime, fileTags, properties);
+                                     lastCommandExecutionTime, lastDuration, rule,
+                                     inputFileTags, fileTags, properties);
     }
 
     bool isValid() const { return !!properties; }
@@ -122,10 +123,15 @@ public:
     RequestedArtifacts artifactsMapRequestedInCommands;
     FileTime lastPrepareScriptExecutionTime;
     FileTime lastCommandExecutionTime;
+    qint64 lastDuration = -1;
     std::unordered_map<QString, ExportedModule> exportedModulesAccessedInPrepareScript;
     std::unordered_map<QString, ExportedModule> exportedModulesAccessedInCommands;
     bool knownOutOfDate = false;
 
+    // Needed to decide whether the prepare script results can be taken over
+    RuleConstPtr rule;
+    std::unordered_map<QString, FileTags> inputFileTags;
+
     // Only needed for API purposes
     FileTags fileTags;
     PropertyMapPtr properties;
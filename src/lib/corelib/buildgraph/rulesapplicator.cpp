@@ -40,6 +40,7 @@
 ****************************************************************************/
 #include "rulesapplicator.h"
 
+#include "autopchscanner.h"
 #include "buildgraph.h"
 #include "productbuilddata.h"
 #include "projectbuilddata.h"
@@ -114,6 +115,8 @@ void RulesApplicator::applyRule(RuleNode *ruleNode, const ArtifactSet &inputArti
     if (m_rule->name.startsWith(QLatin1String("QtCoreMocRule"))) {
         delete m_mocScanner;
         m_mocScanner = new QtMocScanner(m_product, scope());
+    } else if (m_rule->name == QLatin1String("CppAutoPchRule")) {
+        m_autoPchScanner = std::make_unique<AutoPchScanner>(m_product, scope());
     }
     QScriptValue prepareScriptContext = engine()->newObject();
     prepareScriptContext.setPrototype(engine()->globalObject());
@@ -300,11 +303,13 @@ void RulesApplicator::doApply(const ArtifactSet &inputArtifacts, QScriptValue &p
         engine()->setGlobalObject(prepareScriptContext.prototype());
 
     m_transformer->setupOutputs(prepareScriptContext);
-    m_transformer->createCommands(engine(), m_rule->prepareScript,
-            ScriptEngine::argumentList(Rule::argumentNamesForPrepare(), prepareScriptContext));
-    if (Q_UNLIKELY(m_transformer->commands.empty()))
-        throw ErrorInfo(Tr::tr("There is a rule without commands: %1.")
-                        .arg(m_rule->toString()), m_rule->prepareScript.location());
+    if (!rescuePrepareScriptResults(outputArtifacts)) {
+        m_transformer->createCommands(engine(), m_rule->prepareScript,
+                ScriptEngine::argumentList(Rule::argumentNamesForPrepare(), prepareScriptContext));
+        if (Q_UNLIKELY(m_transformer->commands.empty()))
+            throw ErrorInfo(Tr::tr("There is a rule without commands: %1.")
+                            .arg(m_rule->toString()), m_rule->prepareScript.location());
+    }
     if (!m_oldTransformer || m_oldTransformer->outputs != m_transformer->outputs
             || m_oldTransformer->inputs != m_transformer->inputs
             || m_oldTransformer->explicitlyDependsOn != m_transformer->explicitlyDependsOn
@@ -332,6 +337,52 @@ ArtifactSet RulesApplicator::collectOldOutputArtifacts(const ArtifactSet &inputA
     return result;
 }
 
+// After a re-resolve, the rule graph of a changed product is built from scratch, so every
+// rule gets applied to all of its inputs again. If the output artifacts were produced by the
+// same rule from the same inputs before and nothing the prepare script looked at has changed
+// since, we take over the old commands instead of running the prepare script again.
+bool RulesApplicator::rescuePrepareScriptResults(const QList<Artifact *> &outputArtifacts)
+{
+    if (m_oldTransformer || m_mocScanner || m_autoPchScanner || !m_product->buildData)
+        return false;
+    RescuableArtifactData rad;
+    for (const Artifact * const output : outputArtifacts) {
+        const RescuableArtifactData outputRad
+                = m_product->buildData->rescuableArtifactData(output->filePath());
+        if (!outputRad.isValid() || outputRad.commands.empty() || !outputRad.rule)
+            return false;
+        if (!rad.isValid()) {
+            rad = outputRad;
+            if (*rad.rule != *m_rule || rad.inputFileTags != m_transformer->inputFileTags())
+                return false;
+        }
+        else if (outputRad.commands != rad.commands)
+            return false;
+        Set<QString> oldChildren;
+        for (const RescuableArtifactData::ChildData &cd : outputRad.children) {
+            if (!cd.addedByScanner)
+                oldChildren.insert(cd.childFilePath);
+        }
+        Set<QString> newChildren;
+        for (const Artifact * const child : filterByType<Artifact>(output->children))
+            newChildren.insert(child->filePath());
+        if (oldChildren != newChildren)
+            return false;
+    }
+    if (!rad.isValid())
+        return false;
+
+    m_transformer->rescuePrepareScriptResults(rad);
+    m_transformer->prepareScriptNeedsChangeTracking = true;
+    if (prepareScriptNeedsRerun(m_transformer.get(), m_product.get(), m_productsByName,
+                                m_projectsByName)) {
+        m_transformer->exportedModulesAccessedInPrepareScript.clear();
+        return false;
+    }
+    qCDebug(lcBuildGraph) << "re-using prepare script results of rule" << m_rule->toString();
+    return true;
+}
+
 ArtifactSet RulesApplicator::collectAdditionalInputs(const FileTags &tags, const Rule *rule,
                                                      const ResolvedProduct *product,
                                                      InputsSources inputsSources)
@@ -51,11 +51,13 @@
 #include <QtCore/qstring.h>
 #include <QtScript/qscriptvalue.h>
 
+#include <memory>
 #include <unordered_map>
 
 namespace qbs {
 namespace Internal {
 class BuildGraphNode;
+class AutoPchScanner;
 class QtMocScanner;
 class ScriptEngine;
 
@@ -87,6 +89,7 @@ public:
 private:
     void doApply(const ArtifactSet &inputArtifacts, QScriptValue &prepareScriptContext);
     ArtifactSet collectOldOutputArtifacts(const ArtifactSet &inputArtifacts) const;
+    bool rescuePrepareScriptResults(const QList<Artifact *> &outputArtifacts);
 
     struct OutputArtifactInfo {
         Artifact *artifact = nullptr;
@@ -125,6 +128,7 @@ private:
     TransformerPtr m_transformer;
     TransformerConstPtr m_oldTransformer;
     QtMocScanner *m_mocScanner;
+    std::unique_ptr<AutoPchScanner> m_autoPchScanner;
     Logger m_logger;
     bool m_ruleUsesIo = false;
 };
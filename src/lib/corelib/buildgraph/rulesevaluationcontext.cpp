@@ -59,6 +59,8 @@ RulesEvaluationContext::RulesEvaluationContext(Logger logger)
       m_observer(nullptr),
       m_initScopeCalls(0)
 {
+    // Long-running prepare scripts should not delay a build's cancelation noticeably.
+    m_engine->setProcessEventsInterval(100);
     m_prepareScriptScope = m_engine->newObject();
     m_prepareScriptScope.setPrototype(m_engine->globalObject());
     ProcessCommand::setupForJavaScript(m_prepareScriptScope);
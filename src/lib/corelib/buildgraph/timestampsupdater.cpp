@@ -64,6 +64,9 @@ public:
         QBS_CHECK(product->buildData);
         ArtifactVisitor::visitProduct(product);
 
+        // Products depending on this one must get a chance to see the new timestamps.
+        product->buildData->invalidateUpToDateState();
+
         // For target artifacts, we have to update the on-disk timestamp, because
         // the executor will look at it.
         for (Artifact * const targetArtifact : product->targetArtifacts()) {
@@ -39,6 +39,7 @@
 #include "transformer.h"
 
 #include "artifact.h"
+#include "rescuableartifactdata.h"
 #include <jsextensions/moduleproperties.h>
 #include <language/language.h>
 #include <language/preparescriptobserver.h>
@@ -309,6 +310,7 @@ void Transformer::rescueChangeTrackingData(const TransformerConstPtr &other)
     artifactsMapRequestedInPrepareScript = other->artifactsMapRequestedInPrepareScript;
     artifactsMapRequestedInCommands = other->artifactsMapRequestedInCommands;
     lastCommandExecutionTime = other->lastCommandExecutionTime;
+    lastDuration = other->lastDuration;
     lastPrepareScriptExecutionTime = other->lastPrepareScriptExecutionTime;
     prepareScriptNeedsChangeTracking = other->prepareScriptNeedsChangeTracking;
     commandsNeedChangeTracking = other->commandsNeedChangeTracking;
@@ -317,6 +319,21 @@ void Transformer::rescueChangeTrackingData(const TransformerConstPtr &other)
     exportedModulesAccessedInCommands = other->exportedModulesAccessedInCommands;
 }
 
+// Takes over the commands that the prepare script produced in an earlier build, along with
+// the data needed to find out whether the prepare script has to run again.
+void Transformer::rescuePrepareScriptResults(const RescuableArtifactData &rad)
+{
+    commands = rad.commands;
+    propertiesRequestedInPrepareScript = rad.propertiesRequestedInPrepareScript;
+    propertiesRequestedFromArtifactInPrepareScript
+            = rad.propertiesRequestedFromArtifactInPrepareScript;
+    importedFilesUsedInPrepareScript = rad.importedFilesUsedInPrepareScript;
+    depsRequestedInPrepareScript = rad.depsRequestedInPrepareScript;
+    artifactsMapRequestedInPrepareScript = rad.artifactsMapRequestedInPrepareScript;
+    exportedModulesAccessedInPrepareScript = rad.exportedModulesAccessedInPrepareScript;
+    lastPrepareScriptExecutionTime = rad.lastPrepareScriptExecutionTime;
+}
+
 Set<QString> Transformer::jobPools() const
 {
     Set<QString> pools;
@@ -327,5 +344,13 @@ Set<QString> Transformer::jobPools() const
     return pools;
 }
 
+std::unordered_map<QString, FileTags> Transformer::inputFileTags() const
+{
+    std::unordered_map<QString, FileTags> fileTagsByPath;
+    for (const Artifact * const input : inputs)
+        fileTagsByPath.emplace(input->filePath(), input->fileTags());
+    return fileTagsByPath;
+}
+
 } // namespace Internal
 } // namespace qbs
@@ -58,6 +58,7 @@ namespace qbs {
 namespace Internal {
 class Artifact;
 class AbstractCommand;
+class RescuableArtifactData;
 class Rule;
 
 class Transformer
@@ -84,6 +85,7 @@ public:
     RequestedArtifacts artifactsMapRequestedInCommands;
     FileTime lastPrepareScriptExecutionTime;
     FileTime lastCommandExecutionTime;
+    qint64 lastDuration = -1; // Wall-clock time of the last successful run in ms, or -1.
     std::unordered_map<QString, ExportedModule> exportedModulesAccessedInPrepareScript;
     std::unordered_map<QString, ExportedModule> exportedModulesAccessedInCommands;
     bool alwaysRun;
@@ -101,8 +103,10 @@ public:
     void createCommands(ScriptEngine *engine, const PrivateScriptFunction &script,
                         const QScriptValueList &args);
     void rescueChangeTrackingData(const TransformerConstPtr &other);
+    void rescuePrepareScriptResults(const RescuableArtifactData &rad);
 
     Set<QString> jobPools() const;
+    std::unordered_map<QString, FileTags> inputFileTags() const;
 
     template<PersistentPool::OpType opType> void completeSerializationOp(PersistentPool &pool)
     {
@@ -116,7 +120,7 @@ public:
                                      commands, artifactsMapRequestedInPrepareScript,
                                      artifactsMapRequestedInCommands,
                                      lastPrepareScriptExecutionTime, lastCommandExecutionTime,
-                                     exportedModulesAccessedInPrepareScript,
+                                     lastDuration, exportedModulesAccessedInPrepareScript,
                                      exportedModulesAccessedInCommands,
                                      alwaysRun, prepareScriptNeedsChangeTracking,
                                      commandsNeedChangeTracking, markedForRerun);
@@ -64,8 +64,12 @@ public:
 
 private:
     QVariantMap propertyMapByKind(const Property &property) const;
+    bool checkForPropertyChange(const Property &restoredProperty) const;
     bool checkForPropertyChange(const Property &restoredProperty,
                                 const QVariantMap &newProperties) const;
+    bool checkForPropertyChange(const Property &restoredProperty,
+                                const PropertyMapInternal &newProperties) const;
+    bool checkForValueChange(const Property &restoredProperty, const QVariant &newValue) const;
     bool checkForImportFileChange(const std::vector<QString> &importedFiles,
                                   const FileTime &referenceTime,
                                   const char *context) const;
@@ -97,10 +101,6 @@ template<typename T> static QVariantMap getParameterValue(
 QVariantMap TrafoChangeTracker::propertyMapByKind(const Property &property) const
 {
     switch (property.kind) {
-    case Property::PropertyInModule: {
-        const ResolvedProduct * const p = getProduct(property.productName);
-        return p ? p->moduleProperties->value() : QVariantMap();
-    }
     case Property::PropertyInProduct: {
         const ResolvedProduct * const p = getProduct(property.productName);
         return p ? p->productProperties : QVariantMap();
@@ -124,6 +124,7 @@ QVariantMap TrafoChangeTracker::propertyMapByKind(const Property &property) cons
             return v;
         return getParameterValue(p->moduleParameters, depName);
     }
+    case Property::PropertyInModule:
     case Property::PropertyInArtifact:
     default:
         QBS_CHECK(false);
@@ -131,6 +132,31 @@ QVariantMap TrafoChangeTracker::propertyMapByKind(const Property &property) cons
     return {};
 }
 
+bool TrafoChangeTracker::checkForPropertyChange(const Property &restoredProperty) const
+{
+    if (restoredProperty.kind != Property::PropertyInModule)
+        return checkForPropertyChange(restoredProperty, propertyMapByKind(restoredProperty));
+    const ResolvedProduct * const p = getProduct(restoredProperty.productName);
+    if (!p)
+        return checkForValueChange(restoredProperty, QVariant());
+    return checkForPropertyChange(restoredProperty, *p->moduleProperties);
+}
+
+// Module properties make up the bulk of the requested properties, and a lot of transformers
+// share the same property map. The map caches the fingerprints of its values, so in the
+// common case of an unchanged value, all we do is compare two integers.
+bool TrafoChangeTracker::checkForPropertyChange(const Property &restoredProperty,
+                                                const PropertyMapInternal &newProperties) const
+{
+    QBS_CHECK(restoredProperty.kind == Property::PropertyInModule);
+    if (restoredProperty.valueFingerprint() == newProperties.moduleValueFingerprint(
+                restoredProperty.moduleName, restoredProperty.propertyName)) {
+        return false;
+    }
+    return checkForValueChange(restoredProperty, newProperties.moduleProperty(
+                                   restoredProperty.moduleName, restoredProperty.propertyName));
+}
+
 bool TrafoChangeTracker::checkForPropertyChange(const Property &restoredProperty,
                                                 const QVariantMap &newProperties) const
 {
@@ -157,12 +183,19 @@ bool TrafoChangeTracker::checkForPropertyChange(const Property &restoredProperty
     case Property::PropertyInArtifact:
         QBS_CHECK(false);
     }
-    if (restoredProperty.value != v) {
+    return checkForValueChange(restoredProperty, v);
+}
+
+bool TrafoChangeTracker::checkForValueChange(const Property &restoredProperty,
+                                             const QVariant &newValue) const
+{
+    // Differing fingerprints do not imply differing values, e.g. for 1 and 1.0.
+    if (restoredProperty.value != newValue) {
         qCDebug(lcBuildGraph).noquote().nospace()
                 << "Value for property '" << restoredProperty.moduleName << "."
                 << restoredProperty.propertyName << "' has changed.\n"
                 << "Old value was '" << restoredProperty.value << "'.\n"
-                << "New value is '" << v << "'.";
+                << "New value is '" << newValue << "'.";
         return true;
     }
     return false;
@@ -259,7 +292,7 @@ const ResolvedProduct *TrafoChangeTracker::getProduct(const QString &name) const
 bool TrafoChangeTracker::prepareScriptNeedsRerun() const
 {
     for (const Property &property : qAsConst(m_transformer->propertiesRequestedInPrepareScript)) {
-        if (checkForPropertyChange(property, propertyMapByKind(property)))
+        if (checkForPropertyChange(property))
             return true;
     }
 
@@ -279,7 +312,7 @@ bool TrafoChangeTracker::prepareScriptNeedsRerun() const
                     return true;
                 continue;
             }
-            if (checkForPropertyChange(property, artifact->properties->value()))
+            if (checkForPropertyChange(property, *artifact->properties))
                 return true;
         }
     }
@@ -299,7 +332,7 @@ bool TrafoChangeTracker::prepareScriptNeedsRerun() const
 bool TrafoChangeTracker::commandsNeedRerun() const
 {
     for (const Property &property : qAsConst(m_transformer->propertiesRequestedInCommands)) {
-        if (checkForPropertyChange(property, propertyMapByKind(property)))
+        if (checkForPropertyChange(property))
             return true;
     }
 
@@ -315,7 +348,7 @@ bool TrafoChangeTracker::commandsNeedRerun() const
                     return true;
                 continue;
             }
-            if (checkForPropertyChange(property, artifact->properties->value()))
+            if (checkForPropertyChange(property, *artifact->properties))
                 return true;
         }
     }
@@ -0,0 +1,617 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qbs.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "gcccompilerflags.h"
+
+#include "moduleproperties.h"
+
+#include <buildgraph/artifact.h>
+#include <language/language.h>
+#include <language/scriptengine.h>
+#include <logging/translator.h>
+#include <tools/error.h>
+#include <tools/fileinfo.h>
+#include <tools/qttools.h>
+#include <tools/set.h>
+#include <tools/stringconstants.h>
+#include <tools/version.h>
+
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qvariant.h>
+
+namespace qbs {
+namespace Internal {
+
+// The parts of a compiler command line that only depend on the module properties and
+// the language of a source file. The per-file flags go between the lists.
+struct GccConfigurationFlags
+{
+    QStringList leadingFlags;
+    QStringList languageFeatureFlags;
+    QStringList miscFlags;
+    QStringList trailingFlags;
+    QString preincludeFlag;
+    bool needsRandomSeed = false;
+    bool usePrecompiledHeader = false;
+    bool needsModuleOutputFlag = false;
+};
+
+} // namespace Internal
+} // namespace qbs
+
+Q_DECLARE_METATYPE(qbs::Internal::GccConfigurationFlags)
+
+namespace qbs {
+namespace Internal {
+
+class ModulePropertyReader
+{
+public:
+    ModulePropertyReader(ScriptEngine *engine, const ResolvedProduct *product,
+                         const Artifact *artifact)
+        : m_engine(engine), m_product(product), m_artifact(artifact)
+    {
+    }
+
+    QVariant productProperty(const QString &moduleName, const QString &propertyName)
+    {
+        const Property p = ModuleProperties::requestModuleProperty(m_engine, m_product, nullptr,
+                                                                   moduleName, propertyName);
+        m_derivedValue.productProperties.push_back(p);
+        return p.value;
+    }
+
+    QVariant inputProperty(const QString &moduleName, const QString &propertyName)
+    {
+        const Property p = ModuleProperties::requestModuleProperty(m_engine, m_product, m_artifact,
+                                                                   moduleName, propertyName);
+        m_derivedValue.artifactProperties.push_back(p);
+        return p.value;
+    }
+
+    QVariant cppProperty(const QString &propertyName)
+    {
+        return inputProperty(StringConstants::cppModule(), propertyName);
+    }
+
+    // Like ModUtils.moduleProperty() for list properties.
+    QStringList sanitizedCppList(const QString &propertyName)
+    {
+        QStringList list = cppProperty(propertyName).toStringList();
+        if (list.removeAll(QString()) > 0) {
+            m_engine->logger().qbsWarning()
+                    << Tr::tr("Removing empty string from value of property '%1'")
+                       .arg(StringConstants::cppModule() + QLatin1Char('.') + propertyName);
+        }
+        return list;
+    }
+
+    ScriptEngine *engine() const { return m_engine; }
+    ScriptEngine::DerivedPropertyValue &derivedValue() { return m_derivedValue; }
+
+private:
+    ScriptEngine * const m_engine;
+    const ResolvedProduct * const m_product;
+    const Artifact * const m_artifact;
+    ScriptEngine::DerivedPropertyValue m_derivedValue;
+};
+
+// Same semantics as Array.prototype.uniqueConcat.
+static void uniqueConcat(QStringList &list, const QStringList &other)
+{
+    Set<QString> seen;
+    for (const QString &s : qAsConst(list))
+        seen.insert(s);
+    for (const QString &s : other) {
+        if (seen.insert(s).second)
+            list << s;
+    }
+}
+
+static QStringList prefixed(const QString &prefix, const QStringList &list)
+{
+    QStringList result;
+    result.reserve(list.size());
+    for (const QString &s : list)
+        result << prefix + s;
+    return result;
+}
+
+// Like ModUtils.fileTagForTargetLanguage().
+static QString targetLanguageTag(const QStringList &fileTags)
+{
+    static const QStringList sourceTags{
+        QStringLiteral("c"), QStringLiteral("cpp"), QStringLiteral("objc"),
+        QStringLiteral("objcpp"), QStringLiteral("asm"), QStringLiteral("asm_cpp")};
+    static const QStringList pchTags{
+        QStringLiteral("c_pch"), QStringLiteral("cpp_pch"), QStringLiteral("objc_pch"),
+        QStringLiteral("objcpp_pch")};
+    QString tag;
+    int foundTagCount = 0;
+    for (const QString &fileTag : fileTags) {
+        int idx = sourceTags.indexOf(fileTag);
+        if (idx == -1)
+            idx = pchTags.indexOf(fileTag);
+        if (idx == -1)
+            continue;
+        tag = sourceTags.at(idx);
+        if (++foundTagCount > 1)
+            throw ErrorInfo(Tr::tr("source files cannot be identified as more than one language"));
+    }
+    return tag;
+}
+
+// Like ModUtils.languagePropertyName().
+static QString languagePropertyName(const QString &propertyName, const QString &tag)
+{
+    const bool isFlags = propertyName == QLatin1String("flags");
+    const bool isPlatformFlags = propertyName == QLatin1String("platformFlags");
+    if (tag.isEmpty()) {
+        if (isFlags)
+            return QStringLiteral("commonCompilerFlags");
+        if (isPlatformFlags)
+            return QStringLiteral("platformCommonCompilerFlags");
+        return propertyName;
+    }
+    if (tag == QLatin1String("asm") || tag == QLatin1String("asm_cpp")) {
+        if (isFlags)
+            return QStringLiteral("assemblerFlags");
+        if (isPlatformFlags)
+            return QStringLiteral("platformAssemblerFlags");
+        return propertyName;
+    }
+    QString languageName;
+    if (tag == QLatin1String("c"))
+        languageName = QStringLiteral("C");
+    else if (tag == QLatin1String("cpp"))
+        languageName = QStringLiteral("Cxx");
+    else if (tag == QLatin1String("objc"))
+        languageName = QStringLiteral("Objc");
+    else if (tag == QLatin1String("objcpp"))
+        languageName = QStringLiteral("Objcxx");
+    else
+        return propertyName;
+    if (isFlags) {
+        languageName[0] = languageName.at(0).toLower();
+        return languageName + QStringLiteral("Flags");
+    }
+    if (isPlatformFlags)
+        return QStringLiteral("platform") + languageName + QStringLiteral("Flags");
+    if (propertyName == QLatin1String("usePrecompiledHeader"))
+        return QStringLiteral("use") + languageName + QStringLiteral("PrecompiledHeader");
+    return propertyName;
+}
+
+static void addCpuFeatureFlags(ModulePropertyReader &reader, QStringList &flags)
+{
+    const QString architecture = reader.inputProperty(StringConstants::qbsModule(),
+                                                      QStringLiteral("architecture")).toString();
+    if (architecture.isEmpty())
+        return;
+    const QString cpuFeatures = QStringLiteral("cpufeatures");
+    const auto featureFlag = [&](const char *propertyName, const char *flagName) {
+        const QVariant v = reader.inputProperty(cpuFeatures, QLatin1String(propertyName));
+        if (v.userType() != QMetaType::Bool)
+            return;
+        flags << (v.toBool() ? QStringLiteral("-m") : QStringLiteral("-mno-"))
+                 + QLatin1String(flagName);
+    };
+    if (architecture.startsWith(QLatin1String("x86"))) {
+        featureFlag("x86_avx", "avx");
+        featureFlag("x86_avx2", "avx2");
+        featureFlag("x86_avx512bw", "avx512bw");
+        featureFlag("x86_avx512cd", "avx512cd");
+        featureFlag("x86_avx512dq", "avx512dq");
+        featureFlag("x86_avx512er", "avx512er");
+        featureFlag("x86_avx512f", "avx512f");
+        featureFlag("x86_avx512ifma", "avx512ifma");
+        featureFlag("x86_avx512pf", "avx512pf");
+        featureFlag("x86_avx512vbmi", "avx512vbmi");
+        featureFlag("x86_avx512vl", "avx512vl");
+        featureFlag("x86_f16c", "f16c");
+        featureFlag("x86_sse2", "sse2");
+        featureFlag("x86_sse3", "sse3");
+        featureFlag("x86_sse4_1", "sse4.1");
+        featureFlag("x86_sse4_2", "sse4.2");
+        featureFlag("x86_ssse3", "ssse3");
+    } else if (architecture.startsWith(QLatin1String("arm"))) {
+        if (reader.inputProperty(cpuFeatures, QStringLiteral("arm_neon")).toBool())
+            flags << QStringLiteral("-mfpu=neon");
+        if (reader.inputProperty(cpuFeatures, QStringLiteral("arm_vfpv4")).toBool())
+            flags << QStringLiteral("-mfpu=vfpv4");
+    } else if (architecture.startsWith(QLatin1String("mips"))) {
+        featureFlag("mips_dsp", "dsp");
+        featureFlag("mips_dspr2", "dspr2");
+    }
+}
+
+// Like Cpp.languageVersion().
+static QString languageVersion(const QVariant &versionList, const QStringList &knownValues,
+                               const QString &language, const Logger &logger)
+{
+    if (!versionList.isValid())
+        return {};
+    QStringList versions;
+    uniqueConcat(versions, versionList.toStringList());
+    if (versions.size() == 1)
+        return versions.front();
+    for (const QString &candidate : knownValues) {
+        if (versions.contains(candidate))
+            return candidate;
+    }
+    if (versions.empty())
+        return {};
+    logger.qbsDebug() << "Randomly choosing '" << versions.front() << "' from list of unknown "
+                      << language << " version strings (" << versions.join(QLatin1Char(','))
+                      << ")";
+    return versions.front();
+}
+
+// Like standardFallbackValueOrDefault() in gcc.js.
+static QString standardFallbackValueOrDefault(const QStringList &toolchain,
+                                              const QString &compilerVersion,
+                                              const QString &languageVersion,
+                                              const QVariant &useLanguageVersionFallback)
+{
+    if (useLanguageVersionFallback.userType() == QMetaType::Bool
+            && !useLanguageVersionFallback.toBool()) {
+        return languageVersion;
+    }
+
+    struct ToolchainVersion { const char *name; const char *version; };
+    struct LanguageVersion
+    {
+        const char *name;
+        const char *fallback;
+        ToolchainVersion toolchains[3];
+    };
+    static const LanguageVersion languageVersions[] = {
+        {"c++11", "c++0x", {{"xcode", "4.3"}, {"clang", "3.0"}, {"gcc", "4.7"}}},
+        {"c11", "c1x", {{"xcode", "5.0"}, {"clang", "3.1"}, {"gcc", "4.7"}}},
+        {"c++14", "c++1y", {{"xcode", "6.3"}, {"clang", "3.5"}, {"gcc", "4.9"}}},
+        {"c++17", "c++1z", {{"xcode", "9.3"}, {"clang", "5.0"}, {"gcc", "5.1"}}},
+        {"c++20", "c++2a", {{"xcode", nullptr}, {"clang", nullptr}, {"gcc", nullptr}}},
+    };
+    for (const LanguageVersion &lv : languageVersions) {
+        if (languageVersion != QLatin1String(lv.name))
+            continue;
+        for (const ToolchainVersion &tc : lv.toolchains) {
+            if (!toolchain.contains(QLatin1String(tc.name)))
+                continue;
+            if (useLanguageVersionFallback.toBool() || !tc.version
+                    || compare(Version::fromString(compilerVersion),
+                               Version::fromString(QLatin1String(tc.version))) < 0) {
+                return QLatin1String(lv.fallback);
+            }
+            break;
+        }
+        break;
+    }
+    return languageVersion;
+}
+
+// Like WindowsUtils.getWindowsVersionInFormat(version, "hex").
+static QString windowsVersionInHexFormat(const QString &version)
+{
+    const QStringList parts = version.split(QLatin1Char('.'));
+    const int major = parts.at(0).toInt();
+    const int minor = parts.size() > 1 ? parts.at(1).toInt() : 0;
+    return QStringLiteral("0x") + QString::number((major << 8) | minor, 16)
+            .rightJustified(4, QLatin1Char('0')).right(4);
+}
+
+static GccConfigurationFlags configurationFlags(ModulePropertyReader &reader, const QString &tag)
+{
+    const QString &qbsModule = StringConstants::qbsModule();
+    const QString &cppModule = StringConstants::cppModule();
+    const QStringList productToolchain = reader.productProperty(
+                qbsModule, QStringLiteral("toolchain")).toStringList();
+    const QStringList productTargetOS = reader.productProperty(
+                qbsModule, QStringLiteral("targetOS")).toStringList();
+    const bool isClang = productToolchain.contains(QLatin1String("clang"));
+    const bool isCxx = tag == QLatin1String("cpp") || tag == QLatin1String("objcpp");
+    const bool isObjc = tag == QLatin1String("objc") || tag == QLatin1String("objcpp");
+
+    GccConfigurationFlags flags;
+
+    QStringList &leading = flags.leadingFlags;
+    const QVariant appExtensionSafeApi = reader.productProperty(
+                cppModule, QStringLiteral("requireAppExtensionSafeApi"));
+    if (appExtensionSafeApi.isValid() && productTargetOS.contains(QLatin1String("darwin"))) {
+        leading << (appExtensionSafeApi.toBool() ? QStringLiteral("-fapplication-extension")
+                                                 : QStringLiteral("-fno-application-extension"));
+    }
+    leading << reader.productProperty(cppModule, QStringLiteral("sysrootFlags")).toStringList();
+    addCpuFeatureFlags(reader, leading);
+    if (reader.cppProperty(QStringLiteral("debugInformation")).toBool())
+        leading << QStringLiteral("-g");
+    const QString optimization = reader.cppProperty(QStringLiteral("optimization")).toString();
+    if (optimization == QLatin1String("fast"))
+        leading << QStringLiteral("-O2");
+    else if (optimization == QLatin1String("small"))
+        leading << QStringLiteral("-Os");
+    else if (optimization == QLatin1String("none"))
+        leading << QStringLiteral("-O0");
+    const QString warningLevel = reader.cppProperty(QStringLiteral("warningLevel")).toString();
+    if (warningLevel == QLatin1String("none"))
+        leading << QStringLiteral("-w");
+    else if (warningLevel == QLatin1String("all"))
+        leading << QStringLiteral("-Wall") << QStringLiteral("-Wextra");
+    if (reader.cppProperty(QStringLiteral("treatWarningsAsErrors")).toBool())
+        leading << QStringLiteral("-Werror");
+
+    QStringList configFlags = reader.sanitizedCppList(QStringLiteral("platformDriverFlags"))
+            + reader.sanitizedCppList(QStringLiteral("driverFlags"))
+            + reader.sanitizedCppList(QStringLiteral("targetDriverFlags"));
+    uniqueConcat(configFlags, prefixed(QStringLiteral("-F"), reader.cppProperty(
+                                           QStringLiteral("frameworkPaths")).toStringList()));
+    QStringList systemFrameworkPaths;
+    uniqueConcat(systemFrameworkPaths,
+                 reader.cppProperty(QStringLiteral("systemFrameworkPaths")).toStringList());
+    uniqueConcat(systemFrameworkPaths,
+                 reader.cppProperty(QStringLiteral("distributionFrameworkPaths")).toStringList());
+    configFlags << prefixed(QStringLiteral("-iframework"), systemFrameworkPaths);
+    leading << configFlags;
+
+    if (!reader.inputProperty(qbsModule, QStringLiteral("toolchain")).toStringList()
+            .contains(QLatin1String("qcc"))) {
+        leading << QStringLiteral("-pipe");
+    }
+
+    QStringList &features = flags.languageFeatureFlags;
+    if (reader.cppProperty(QStringLiteral("enableReproducibleBuilds")).toBool()) {
+        flags.needsRandomSeed = !isClang;
+        const int major = reader.productProperty(
+                    cppModule, QStringLiteral("compilerVersionMajor")).toInt();
+        const int minor = reader.productProperty(
+                    cppModule, QStringLiteral("compilerVersionMinor")).toInt();
+        if ((isClang && (major > 3 || (major == 3 && minor >= 5)))
+                || (productToolchain.contains(QLatin1String("gcc"))
+                    && (major > 4 || (major == 4 && minor >= 9)))) {
+            features << QStringLiteral("-Wdate-time");
+        }
+    }
+
+    const QVariant useArc = reader.cppProperty(QStringLiteral("automaticReferenceCounting"));
+    if (useArc.isValid() && isObjc) {
+        features << (useArc.toBool() ? QStringLiteral("-fobjc-arc")
+                                     : QStringLiteral("-fno-objc-arc"));
+    }
+    const QVariant enableExceptions = reader.cppProperty(QStringLiteral("enableExceptions"));
+    if (enableExceptions.isValid()) {
+        const bool enable = enableExceptions.toBool();
+        if (isCxx) {
+            features << (enable ? QStringLiteral("-fexceptions")
+                                : QStringLiteral("-fno-exceptions"));
+        }
+        if (isObjc) {
+            features << (enable ? QStringLiteral("-fobjc-exceptions")
+                                : QStringLiteral("-fno-objc-exceptions"));
+            if (useArc.isValid()) {
+                features << (useArc.toBool() ? QStringLiteral("-fobjc-arc-exceptions")
+                                             : QStringLiteral("-fno-objc-arc-exceptions"));
+            }
+        }
+    }
+    const QVariant enableRtti = reader.cppProperty(QStringLiteral("enableRtti"));
+    if (enableRtti.isValid() && isCxx)
+        features << (enableRtti.toBool() ? QStringLiteral("-frtti") : QStringLiteral("-fno-rtti"));
+    const QString visibility = reader.cppProperty(QStringLiteral("visibility")).toString();
+    if (!productToolchain.contains(QLatin1String("mingw"))) {
+        if (visibility == QLatin1String("hidden") || visibility == QLatin1String("minimal"))
+            features << QStringLiteral("-fvisibility=hidden");
+        if ((visibility == QLatin1String("hiddenInlines")
+             || visibility == QLatin1String("minimal")) && tag == QLatin1String("cpp")) {
+            features << QStringLiteral("-fvisibility-inlines-hidden");
+        }
+        if (visibility == QLatin1String("default"))
+            features << QStringLiteral("-fvisibility=default");
+    }
+
+    flags.miscFlags
+            = reader.sanitizedCppList(languagePropertyName(QStringLiteral("platformFlags"), {}))
+            + reader.sanitizedCppList(languagePropertyName(QStringLiteral("flags"), {}))
+            + reader.sanitizedCppList(languagePropertyName(QStringLiteral("platformFlags"), tag))
+            + reader.sanitizedCppList(languagePropertyName(QStringLiteral("flags"), tag));
+
+    flags.preincludeFlag = reader.cppProperty(QStringLiteral("preincludeFlag")).toString();
+    if (tag != QLatin1String("asm_cpp")) {
+        flags.usePrecompiledHeader = reader.cppProperty(
+                    languagePropertyName(QStringLiteral("usePrecompiledHeader"), tag)).toBool();
+    }
+
+    QStringList &trailing = flags.trailingFlags;
+    trailing << prefixed(flags.preincludeFlag,
+                         reader.cppProperty(QStringLiteral("prefixHeaders")).toStringList());
+    if (reader.cppProperty(QStringLiteral("positionIndependentCode")).toBool()
+            && !productTargetOS.contains(QLatin1String("windows"))) {
+        trailing << QStringLiteral("-fPIC");
+    }
+    trailing << prefixed(QStringLiteral("-Wp,"),
+                         reader.cppProperty(QStringLiteral("cppFlags")).toStringList());
+
+    const QString defineFlag = reader.cppProperty(QStringLiteral("defineFlag")).toString();
+    QStringList defines;
+    uniqueConcat(defines, reader.cppProperty(QStringLiteral("platformDefines")).toStringList());
+    uniqueConcat(defines, reader.cppProperty(QStringLiteral("defines")).toStringList());
+    trailing << prefixed(defineFlag, defines);
+    QStringList includePaths;
+    uniqueConcat(includePaths, reader.cppProperty(QStringLiteral("includePaths")).toStringList());
+    trailing << prefixed(reader.cppProperty(QStringLiteral("includeFlag")).toString(),
+                         includePaths);
+    QStringList systemIncludePaths;
+    uniqueConcat(systemIncludePaths,
+                 reader.cppProperty(QStringLiteral("systemIncludePaths")).toStringList());
+    uniqueConcat(systemIncludePaths,
+                 reader.cppProperty(QStringLiteral("distributionIncludePaths")).toStringList());
+    trailing << prefixed(reader.cppProperty(QStringLiteral("systemIncludeFlag")).toString(),
+                         systemIncludePaths);
+
+    const QString minimumWindowsVersion
+            = reader.cppProperty(QStringLiteral("minimumWindowsVersion")).toString();
+    if (!minimumWindowsVersion.isEmpty() && productTargetOS.contains(QLatin1String("windows"))) {
+        const QString hexVersion = windowsVersionInHexFormat(minimumWindowsVersion);
+        for (const char *versionDef : {"WINVER", "_WIN32_WINNT", "_WIN32_WINDOWS"})
+            trailing << defineFlag + QLatin1String(versionDef) + QLatin1Char('=') + hexVersion;
+    }
+
+    QString langVersion;
+    const Logger &logger = reader.engine()->logger();
+    if (tag == QLatin1String("c") || tag == QLatin1String("objc")) {
+        static const QStringList knownValues{
+            QStringLiteral("c11"), QStringLiteral("c99"), QStringLiteral("c90"),
+            QStringLiteral("c89")};
+        langVersion = languageVersion(reader.cppProperty(QStringLiteral("cLanguageVersion")),
+                                      knownValues, QStringLiteral("C"), logger);
+    } else if (isCxx) {
+        static const QStringList knownValues{
+            QStringLiteral("c++20"), QStringLiteral("c++2a"), QStringLiteral("c++17"),
+            QStringLiteral("c++1z"), QStringLiteral("c++14"), QStringLiteral("c++1y"),
+            QStringLiteral("c++11"), QStringLiteral("c++0x"), QStringLiteral("c++03"),
+            QStringLiteral("c++98")};
+        langVersion = languageVersion(reader.cppProperty(QStringLiteral("cxxLanguageVersion")),
+                                      knownValues, QStringLiteral("C++"), logger);
+    }
+    if (!langVersion.isEmpty()) {
+        trailing << QStringLiteral("-std=") + standardFallbackValueOrDefault(
+                        productToolchain,
+                        reader.productProperty(cppModule,
+                                               QStringLiteral("compilerVersion")).toString(),
+                        langVersion,
+                        reader.productProperty(cppModule,
+                                               QStringLiteral("useLanguageVersionFallback")));
+    }
+
+    if (isCxx) {
+        const QString cxxStandardLibrary = reader.productProperty(
+                    cppModule, QStringLiteral("cxxStandardLibrary")).toString();
+        if (!cxxStandardLibrary.isEmpty() && isClang)
+            trailing << QStringLiteral("-stdlib=") + cxxStandardLibrary;
+        if (reader.cppProperty(QStringLiteral("enableCxxModules")).toBool()) {
+            if (isClang) {
+                trailing << QStringLiteral("-fprebuilt-module-path=") + reader.cppProperty(
+                                QStringLiteral("_compiledModuleDirectory")).toString();
+                flags.needsModuleOutputFlag = true;
+            } else {
+                trailing << QStringLiteral("-fmodules-ts");
+            }
+        }
+    }
+
+    return flags;
+}
+
+QStringList gccCompilerFlags(ScriptEngine *engine, const QScriptValue &project,
+                             const QScriptValue &product, const QScriptValue &input,
+                             const QScriptValue &output, const QScriptValue &language,
+                             const QScriptValue &explicitlyDependsOn,
+                             const QScriptValue &compiledModuleOutput)
+{
+    const ResolvedProduct * const resolvedProduct = ModuleProperties::objectPointers(product).first;
+    const Artifact * const inputArtifact = ModuleProperties::objectPointers(input).second;
+    if (!resolvedProduct || !inputArtifact) {
+        throw ErrorInfo(Tr::tr("gccCompilerFlags() expects the product and the input "
+                               "of a rule."));
+    }
+
+    const QStringList outputTags = output.property(StringConstants::fileTagsProperty())
+            .toVariant().toStringList();
+    const QString tag = targetLanguageTag(inputArtifact->fileTags().toStringList() + outputTags);
+    static const QStringList supportedTags{
+        QStringLiteral("c"), QStringLiteral("cpp"), QStringLiteral("objc"),
+        QStringLiteral("objcpp"), QStringLiteral("asm_cpp")};
+    if (!supportedTags.contains(tag))
+        throw ErrorInfo(Tr::tr("unsupported source language: %1").arg(tag));
+
+    const QString cacheKey = QStringLiteral("gccCompilerFlags:") + tag;
+    GccConfigurationFlags config;
+    const QVariant cachedConfig = engine->isPropertyCacheEnabled()
+            ? engine->retrieveFromDerivedValueCache(cacheKey, inputArtifact) : QVariant();
+    if (cachedConfig.isValid()) {
+        config = cachedConfig.value<GccConfigurationFlags>();
+    } else {
+        ModulePropertyReader reader(engine, resolvedProduct, inputArtifact);
+        config = configurationFlags(reader, tag);
+        if (engine->isPropertyCacheEnabled()) {
+            reader.derivedValue().value = QVariant::fromValue(config);
+            engine->addToDerivedValueCache(cacheKey, inputArtifact, reader.derivedValue());
+        }
+    }
+
+    const QString &inputFilePath = inputArtifact->filePath();
+    QStringList args = config.leadingFlags;
+    if (config.needsRandomSeed) {
+        const QString sourceDirectory
+                = project.property(StringConstants::sourceDirectoryProperty()).toString();
+        const QByteArray hash = QCryptographicHash::hash(
+                    QDir(sourceDirectory).relativeFilePath(inputFilePath).toLatin1(),
+                    QCryptographicHash::Sha1).toHex().left(8);
+        args << QStringLiteral("-frandom-seed=0x") + QString::fromLatin1(hash);
+    }
+    args << config.languageFeatureFlags;
+    if (language.isArray())
+        args << language.toVariant().toStringList();
+    args << config.miscFlags;
+    const QString pchTag = tag + QStringLiteral("_pch");
+    if (config.usePrecompiledHeader && !outputTags.contains(pchTag)) {
+        const QScriptValue pchInputs = explicitlyDependsOn.property(pchTag);
+        if (pchInputs.isArray()
+                && pchInputs.property(StringConstants::lengthProperty()).toInt32() == 1) {
+            const QScriptValue pchInput = pchInputs.property(0);
+            args << config.preincludeFlag << FileInfo::resolvePath(
+                        FileInfo::path(pchInput.property(
+                                           StringConstants::filePathProperty()).toString()),
+                        pchInput.property(QStringLiteral("completeBaseName")).toString());
+        }
+    }
+    args << config.trailingFlags;
+    if (config.needsModuleOutputFlag && compiledModuleOutput.isObject()) {
+        args << QStringLiteral("-fmodule-output=")
+                + compiledModuleOutput.property(StringConstants::filePathProperty()).toString();
+    }
+    args << QStringLiteral("-o")
+         << output.property(StringConstants::filePathProperty()).toString()
+         << QStringLiteral("-c") << inputFilePath;
+    return args;
+}
+
+} // namespace Internal
+} // namespace qbs
@@ -1,6 +1,7 @@
 QT += xml
 
 HEADERS += \
+    $$PWD/gcccompilerflags.h \
     $$PWD/moduleproperties.h \
     $$PWD/jsextensions.h
 
@@ -8,6 +9,7 @@ SOURCES += \
     $$PWD/environmentextension.cpp \
     $$PWD/file.cpp \
     $$PWD/fileinfoextension.cpp \
+    $$PWD/gcccompilerflags.cpp \
     $$PWD/temporarydir.cpp \
     $$PWD/textfile.cpp \
     $$PWD/binaryfile.cpp \
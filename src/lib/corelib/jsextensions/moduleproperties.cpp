@@ -72,9 +72,9 @@ QScriptValue getDataForModuleScriptValue(QScriptEngine *engine, const ResolvedPr
     return data;
 }
 
-static QScriptValue getModuleProperty(const ResolvedProduct *product, const Artifact *artifact,
-                                      ScriptEngine *engine, const QString &moduleName,
-                                      const QString &propertyName, bool *isPresent = nullptr)
+Property ModuleProperties::requestModuleProperty(ScriptEngine *engine,
+        const ResolvedProduct *product, const Artifact *artifact, const QString &moduleName,
+        const QString &propertyName, bool *isPresent)
 {
     const PropertyMapConstPtr &properties = artifact ? artifact->properties
                                                      : product->moduleProperties;
@@ -98,8 +98,16 @@ static QScriptValue getModuleProperty(const ResolvedProduct *product, const Arti
         engine->addPropertyRequestedFromArtifact(artifact, p);
     else
         engine->addPropertyRequestedInScript(p);
+    return p;
+}
 
-    return engine->toScriptValue(value);
+static QScriptValue getModuleProperty(const ResolvedProduct *product, const Artifact *artifact,
+                                      ScriptEngine *engine, const QString &moduleName,
+                                      const QString &propertyName, bool *isPresent = nullptr)
+{
+    return engine->toScriptValue(ModuleProperties::requestModuleProperty(
+                                     engine, product, artifact, moduleName, propertyName,
+                                     isPresent).value);
 }
 
 class ModulePropertyScriptClass : public QScriptClass
@@ -304,6 +312,25 @@ void ModuleProperties::setupModules(QScriptValue &object, const ResolvedProduct
     }
 }
 
+std::pair<const ResolvedProduct *, const Artifact *> ModuleProperties::objectPointers(
+        const QScriptValue &object)
+{
+    const QScriptValue ptrScriptValue = object.property(ptrKey());
+    if (!ptrScriptValue.isNumber())
+        return {};
+    const void *ptr = reinterpret_cast<const void *>(qscriptvalue_cast<quintptr>(ptrScriptValue));
+    if (!ptr)
+        return {};
+    const QString type = object.property(typeKey()).toString();
+    if (type == StringConstants::productValue())
+        return {static_cast<const ResolvedProduct *>(ptr), nullptr};
+    if (type == artifactType()) {
+        const auto artifact = static_cast<const Artifact *>(ptr);
+        return {artifact->product.get(), artifact};
+    }
+    return {};
+}
+
 QScriptValue ModuleProperties::js_moduleProperty(QScriptContext *context, QScriptEngine *engine)
 {
     try {
@@ -332,17 +359,10 @@ QScriptValue ModuleProperties::moduleProperty(QScriptContext *context, QScriptEn
                 QStringLiteral("Internal error: __internalPtr not set up"));
     }
 
-    const void *ptr = reinterpret_cast<const void *>(qscriptvalue_cast<quintptr>(ptrScriptValue));
-    const ResolvedProduct *product = nullptr;
-    const Artifact *artifact = nullptr;
-    if (typeScriptValue.toString() == StringConstants::productValue()) {
-        QBS_ASSERT(ptr, return {});
-        product = static_cast<const ResolvedProduct *>(ptr);
-    } else if (typeScriptValue.toString() == artifactType()) {
-        QBS_ASSERT(ptr, return {});
-        artifact = static_cast<const Artifact *>(ptr);
-        product = artifact->product.get();
-    } else {
+    const auto pointers = objectPointers(objectWithProperties);
+    const ResolvedProduct * const product = pointers.first;
+    const Artifact * const artifact = pointers.second;
+    if (Q_UNLIKELY(!product)) {
         return context->throwError(QScriptContext::TypeError,
                                    QStringLiteral("Internal error: invalid type"));
     }
@@ -42,10 +42,13 @@
 
 #include <buildgraph/forward_decls.h>
 #include <language/forward_decls.h>
+#include <language/property.h>
 
 #include <QtScript/qscriptcontext.h>
 #include <QtScript/qscriptvalue.h>
 
+#include <utility>
+
 namespace qbs {
 namespace Internal {
 
@@ -70,6 +73,16 @@ public:
     static void setModuleScriptValue(QScriptValue targetObject, const QScriptValue &moduleObject,
                                      const QString &moduleName);
 
+    // The product and, for artifacts, the artifact represented by an object set up via init().
+    static std::pair<const ResolvedProduct *, const Artifact *> objectPointers(
+            const QScriptValue &object);
+
+    // Looks up a module property for native code and records it as requested,
+    // exactly like an access from a script does.
+    static Property requestModuleProperty(ScriptEngine *engine, const ResolvedProduct *product,
+                                          const Artifact *artifact, const QString &moduleName,
+                                          const QString &propertyName, bool *isPresent = nullptr);
+
 private:
     static void init(QScriptValue objectWithProperties, const void *ptr, const QString &type);
     static void setupModules(QScriptValue &object, const ResolvedProduct *product,
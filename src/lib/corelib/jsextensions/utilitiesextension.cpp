@@ -38,6 +38,7 @@
 ****************************************************************************/
 
 #include <api/languageinfo.h>
+#include <jsextensions/gcccompilerflags.h>
 #include <jsextensions/jsextensions.h>
 #include <language/scriptengine.h>
 #include <logging/translator.h>
@@ -105,6 +106,7 @@ public:
     static QScriptValue js_canonicalToolchain(QScriptContext *context, QScriptEngine *engine);
     static QScriptValue js_cStringQuote(QScriptContext *context, QScriptEngine *engine);
     static QScriptValue js_getHash(QScriptContext *context, QScriptEngine *engine);
+    static QScriptValue js_getFileHash(QScriptContext *context, QScriptEngine *engine);
     static QScriptValue js_getNativeSetting(QScriptContext *context, QScriptEngine *engine);
     static QScriptValue js_kernelVersion(QScriptContext *context, QScriptEngine *engine);
     static QScriptValue js_nativeSettingGroups(QScriptContext *context, QScriptEngine *engine);
@@ -119,6 +121,7 @@ public:
     static QScriptValue js_installedClangCls(QScriptContext *context, QScriptEngine *engine);
 
     static QScriptValue js_versionCompare(QScriptContext *context, QScriptEngine *engine);
+    static QScriptValue js_gccCompilerFlags(QScriptContext *context, QScriptEngine *engine);
 
     static QScriptValue js_qmlTypeInfo(QScriptContext *context, QScriptEngine *engine);
     static QScriptValue js_builtinExtensionNames(QScriptContext *context, QScriptEngine *engine);
@@ -352,6 +355,27 @@ QScriptValue UtilitiesExtension::js_getHash(QScriptContext *context, QScriptEngi
     return engine->toScriptValue(QString::fromLatin1(hash));
 }
 
+QScriptValue UtilitiesExtension::js_getFileHash(QScriptContext *context, QScriptEngine *engine)
+{
+    if (Q_UNLIKELY(context->argumentCount() < 1)) {
+        return context->throwError(QScriptContext::SyntaxError,
+                                   QStringLiteral("getFileHash expects 1 argument"));
+    }
+    static_cast<ScriptEngine *>(engine)->setUsesIo();
+    const QString filePath = context->argument(0).toString();
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return context->throwError(QStringLiteral("Cannot open file '%1': %2")
+                                   .arg(QDir::toNativeSeparators(filePath), file.errorString()));
+    }
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    if (!hash.addData(&file)) {
+        return context->throwError(QStringLiteral("Cannot read file '%1': %2")
+                                   .arg(QDir::toNativeSeparators(filePath), file.errorString()));
+    }
+    return engine->toScriptValue(QString::fromLatin1(hash.result().toHex()));
+}
+
 QScriptValue UtilitiesExtension::js_getNativeSetting(QScriptContext *context, QScriptEngine *engine)
 {
     if (Q_UNLIKELY(context->argumentCount() < 1 || context->argumentCount() > 3)) {
@@ -653,6 +677,23 @@ QScriptValue UtilitiesExtension::js_versionCompare(QScriptContext *context, QScr
         QStringLiteral("versionCompare expects two arguments of type string"));
 }
 
+QScriptValue UtilitiesExtension::js_gccCompilerFlags(QScriptContext *context,
+                                                     QScriptEngine *engine)
+{
+    if (Q_UNLIKELY(context->argumentCount() < 5)) {
+        return context->throwError(QScriptContext::SyntaxError,
+                                   QStringLiteral("gccCompilerFlags expects at least 5 arguments"));
+    }
+    try {
+        return engine->toScriptValue(gccCompilerFlags(
+                static_cast<ScriptEngine *>(engine), context->argument(0), context->argument(1),
+                context->argument(2), context->argument(3), context->argument(4),
+                context->argument(5), context->argument(6)));
+    } catch (const ErrorInfo &e) {
+        return context->throwError(e.toString());
+    }
+}
+
 QScriptValue UtilitiesExtension::js_qmlTypeInfo(QScriptContext *context, QScriptEngine *engine)
 {
     Q_UNUSED(context);
@@ -919,6 +960,8 @@ void initializeJsExtensionUtilities(QScriptValue extensionObject)
                                engine->newFunction(UtilitiesExtension::js_cStringQuote, 1));
     environmentObj.setProperty(QStringLiteral("getHash"),
                                engine->newFunction(UtilitiesExtension::js_getHash, 1));
+    environmentObj.setProperty(QStringLiteral("getFileHash"),
+                               engine->newFunction(UtilitiesExtension::js_getFileHash, 1));
     environmentObj.setProperty(QStringLiteral("getNativeSetting"),
                                engine->newFunction(UtilitiesExtension::js_getNativeSetting, 3));
     environmentObj.setProperty(QStringLiteral("kernelVersion"),
@@ -943,6 +986,8 @@ void initializeJsExtensionUtilities(QScriptValue extensionObject)
                                engine->newFunction(UtilitiesExtension::js_installedClangCls, 1));
     environmentObj.setProperty(QStringLiteral("versionCompare"),
                                engine->newFunction(UtilitiesExtension::js_versionCompare, 2));
+    environmentObj.setProperty(QStringLiteral("gccCompilerFlags"),
+                               engine->newFunction(UtilitiesExtension::js_gccCompilerFlags, 7));
     environmentObj.setProperty(QStringLiteral("qmlTypeInfo"),
                                engine->newFunction(UtilitiesExtension::js_qmlTypeInfo, 0));
     environmentObj.setProperty(QStringLiteral("builtinExtensionNames"),
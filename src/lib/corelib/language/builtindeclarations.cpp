@@ -325,6 +325,7 @@ void BuiltinDeclarations::addModuleProviderItem()
 {
     ItemDeclaration item(ItemType::ModuleProvider);
     item << nameProperty()
+         << PropertyDeclaration(QStringLiteral("cacheKey"), PropertyDeclaration::String)
          << PropertyDeclaration(QStringLiteral("outputBaseDir"), PropertyDeclaration::String)
          << PropertyDeclaration(QStringLiteral("relativeSearchPaths"),
                                 PropertyDeclaration::StringList);
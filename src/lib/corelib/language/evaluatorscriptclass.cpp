@@ -61,6 +61,7 @@
 #include <QtScript/qscriptstring.h>
 #include <QtScript/qscriptvalue.h>
 
+#include <algorithm>
 #include <utility>
 
 namespace qbs {
@@ -407,7 +408,10 @@ QScriptClass::QueryFlags EvaluatorScriptClass::queryProperty(const QScriptValue
         return {};
     }
 
-    return queryItemProperty(data, nameString);
+    const QueryFlags queryFlags = queryItemProperty(data, nameString);
+    if (!queryFlags && !m_bindingRecorders.empty())
+        recordRead(data->item, nameString, QScriptValue());
+    return queryFlags;
 }
 
 QScriptClass::QueryFlags EvaluatorScriptClass::queryItemProperty(const EvaluationData *data,
@@ -618,6 +622,252 @@ void EvaluatorScriptClass::convertToPropertyType(const Item *item, const Propert
     convertToPropertyType_impl(m_pathPropertiesBaseDir, item, decl, value->location(), v);
 }
 
+class BindingRecorderScope
+{
+public:
+    BindingRecorderScope(std::vector<EvaluatorScriptClass::BindingRecorder *> &recorders,
+                         EvaluatorScriptClass::BindingRecorder *recorder)
+        : m_recorders(recorders)
+    {
+        m_recorders.push_back(recorder);
+    }
+
+    ~BindingRecorderScope() { m_recorders.pop_back(); }
+
+private:
+    std::vector<EvaluatorScriptClass::BindingRecorder *> &m_recorders;
+};
+
+static const Item *itemValueTarget(const Item *item, const QString &name)
+{
+    const ValuePtr v = item->property(name);
+    return v && v->type() == Value::ItemValueType
+            ? std::static_pointer_cast<ItemValue>(v)->item() : nullptr;
+}
+
+EvaluatorScriptClass::BindingContext EvaluatorScriptClass::bindingContext(
+        const Value *value, const EvaluationData *data)
+{
+    BindingContext context;
+    context.moduleInstance = data->item;
+    context.fileIdScope = static_cast<const JSSourceValue *>(value)->file()->idScope();
+    return context;
+}
+
+static bool isMemoizableBinding(const Value *value, const Item *itemOfProperty, const Item *item)
+{
+    if (value->type() != Value::JSSourceValueType || value->next())
+        return false;
+    if (itemOfProperty->type() != ItemType::Module || item->type() != ItemType::ModuleInstance)
+        return false;
+    const auto sourceValue = static_cast<const JSSourceValue *>(value);
+    return sourceValue->alternatives().empty() && !sourceValue->sourceUsesOuter()
+            && !sourceValue->sourceUsesOriginal();
+}
+
+const Item *EvaluatorScriptClass::resolveItem(const MemoizedItem &item,
+                                              const BindingContext &context)
+{
+    const Item * const moduleScope = context.moduleInstance->scope();
+    switch (item.kind) {
+    case MemoizedItem::Instance:
+        return context.moduleInstance;
+    case MemoizedItem::ScopeChain: {
+        const Item *scope = moduleScope;
+        for (int i = 0; scope && i < item.depth; ++i)
+            scope = scope->scope();
+        return scope;
+    }
+    case MemoizedItem::ModuleScopeItem:
+        return moduleScope ? itemValueTarget(moduleScope, item.name) : nullptr;
+    case MemoizedItem::ProductModule: {
+        const Item *current = moduleScope
+                ? itemValueTarget(moduleScope, StringConstants::productVar()) : nullptr;
+        if (!current || current->type() != ItemType::Product)
+            return nullptr;
+        for (const QString &part : QualifiedId::fromString(item.name)) {
+            current = itemValueTarget(current, part);
+            if (!current)
+                return nullptr;
+        }
+        return current->type() == ItemType::ModuleInstance ? current : nullptr;
+    }
+    case MemoizedItem::FileIdScope:
+        return context.fileIdScope;
+    }
+    return nullptr;
+}
+
+bool EvaluatorScriptClass::describeItem(const Item *item, const BindingContext &context,
+                                        MemoizedItem *result) const
+{
+    if (item == context.moduleInstance) {
+        result->kind = MemoizedItem::Instance;
+        return true;
+    }
+    if (item == context.fileIdScope) {
+        result->kind = MemoizedItem::FileIdScope;
+        return true;
+    }
+    const Item * const moduleScope = context.moduleInstance->scope();
+    if (!moduleScope)
+        return false;
+    int depth = 0;
+    for (const Item *scope = moduleScope; scope; scope = scope->scope(), ++depth) {
+        if (item == scope) {
+            result->kind = MemoizedItem::ScopeChain;
+            result->depth = depth;
+            return true;
+        }
+    }
+    if (item->type() == ItemType::ModuleInstance) {
+        const VariantValueConstPtr name = item->variantProperty(StringConstants::nameProperty());
+        if (!name)
+            return false;
+        result->kind = MemoizedItem::ProductModule;
+        result->name = name->value().toString();
+
+        // Module instances attached to groups or other modules are not reachable from
+        // the product under their name.
+        return resolveItem(*result, context) == item;
+    }
+    for (auto it = moduleScope->properties().cbegin(); it != moduleScope->properties().cend();
+         ++it) {
+        if (it.value()->type() == Value::ItemValueType
+                && std::static_pointer_cast<ItemValue>(it.value())->item() == item) {
+            result->kind = MemoizedItem::ModuleScopeItem;
+            result->name = it.key();
+            return true;
+        }
+    }
+    return false;
+}
+
+bool EvaluatorScriptClass::describeValue(const QScriptValue &value, const BindingContext &context,
+                                         MemoizedValue *result) const
+{
+    if (!value.isValid()) {
+        result->kind = MemoizedValue::Absent;
+        return true;
+    }
+    if (value.isUndefined()) {
+        result->kind = MemoizedValue::Undefined;
+        return true;
+    }
+    if (value.isObject() && value.scriptClass() == this) {
+        const auto data = attachedPointer<EvaluationData>(value);
+        if (!data || !describeItem(data->item, context, &result->item))
+            return false;
+        result->kind = MemoizedValue::ItemReference;
+        return true;
+    }
+    if (!isPlainData(value))
+        return false;
+    result->kind = MemoizedValue::Data;
+    result->data = value.toVariant();
+    return true;
+}
+
+// Only values that survive a round-trip through QVariant without losing identity or
+// ordering information qualify. In particular, objects are excluded, because QVariantMap
+// does not preserve the property order.
+bool EvaluatorScriptClass::isPlainData(const QScriptValue &value, int depth) const
+{
+    if (value.isBool() || value.isNumber() || value.isString())
+        return true;
+    if (depth > 32 || !value.isArray())
+        return false;
+    const quint32 length = value.property(StringConstants::lengthProperty()).toUInt32();
+    for (quint32 i = 0; i < length; ++i) {
+        if (!isPlainData(value.property(i), depth + 1))
+            return false;
+    }
+    return true;
+}
+
+void EvaluatorScriptClass::recordRead(const Item *item, const QString &name,
+                                      const QScriptValue &value)
+{
+    if (m_bindingRecorders.empty())
+        return;
+    BindingRecorder * const recorder = m_bindingRecorders.back();
+    if (!recorder || !recorder->valid)
+        return;
+    if (!recorder->seenReads.insert(std::make_pair(item, name)).second)
+        return;
+    MemoizedRead read;
+    read.propertyName = name;
+    if (!describeItem(item, recorder->context, &read.item)
+            || !describeValue(value, recorder->context, &read.value)) {
+        recorder->valid = false;
+        return;
+    }
+    recorder->reads.push_back(std::move(read));
+}
+
+bool EvaluatorScriptClass::lookUpMemoizedBinding(const ValuePtr &value,
+                                                 const EvaluationData *data, QScriptValue *result)
+{
+    const auto it = m_memoizedBindings.find(value.get());
+    if (it == m_memoizedBindings.end())
+        return false;
+    if (it->value.lock() != value) {
+        m_memoizedBindings.erase(it);
+        return false;
+    }
+
+    // Replaying the reads can evaluate other properties, which might add to the hash.
+    const std::vector<MemoizedBinding> candidates = it->bindings;
+
+    // The replayed reads are not dependencies of any binding that is currently being recorded.
+    const BindingRecorderScope recorderScope(m_bindingRecorders, nullptr);
+
+    const BindingContext context = bindingContext(value.get(), data);
+    const auto readMatches = [this, data, &context](const MemoizedRead &read) {
+        const Item * const item = resolveItem(read.item, context);
+        if (!item)
+            return false;
+        const QScriptValue v = data->evaluator->scriptValue(item)
+                .property(read.propertyName, QScriptValue::ResolveLocal);
+        MemoizedValue currentValue;
+        return describeValue(v, context, &currentValue) && currentValue == read.value;
+    };
+    for (const MemoizedBinding &candidate : candidates) {
+        if (!std::all_of(candidate.reads.cbegin(), candidate.reads.cend(), readMatches))
+            continue;
+        *result = candidate.result.kind == MemoizedValue::Undefined
+                ? engine()->undefinedValue() : engine()->toScriptValue(candidate.result.data);
+        static_cast<ScriptEngine *>(engine())->addMemoizedBindingHit();
+        return true;
+    }
+    return false;
+}
+
+void EvaluatorScriptClass::memoizeBinding(const ValuePtr &value, BindingRecorder &recorder,
+                                          const QScriptValue &result)
+{
+    static const std::size_t maxBindingsPerValue = 8;
+    if (!recorder.valid || static_cast<ScriptEngine *>(engine())->hasErrorOrException(result))
+        return;
+    MemoizedBinding binding;
+    if (!describeValue(result, recorder.context, &binding.result))
+        return;
+    if (binding.result.kind != MemoizedValue::Undefined
+            && binding.result.kind != MemoizedValue::Data) {
+        return;
+    }
+    MemoizedBindings &entry = m_memoizedBindings[value.get()];
+    if (entry.value.lock() != value) {
+        entry.value = value;
+        entry.bindings.clear();
+    }
+    std::vector<MemoizedBinding> &bindings = entry.bindings;
+    if (bindings.size() >= maxBindingsPerValue)
+        return;
+    binding.reads = std::move(recorder.reads);
+    bindings.push_back(std::move(binding));
+}
+
 class PropertyStackManager
 {
 public:
@@ -667,9 +917,11 @@ QScriptValue EvaluatorScriptClass::property(const QScriptValue &object, const QS
 
     const auto qpt = static_cast<QueryPropertyType>(id);
     if (qpt == QPTParentProperty) {
-        return data->item->parent()
+        const QScriptValue parent = data->item->parent()
                 ? data->evaluator->scriptValue(data->item->parent())
                 : engine()->undefinedValue();
+        recordRead(data->item, name.toString(), parent);
+        return parent;
     }
 
     ValuePtr value;
@@ -689,19 +941,35 @@ QScriptValue EvaluatorScriptClass::property(const QScriptValue &object, const QS
         if (result.isValid()) {
             if (debugProperties)
                 qDebug() << "[SC] cache hit " << name << ": " << resultToString(result);
+            recordRead(data->item, name.toString(), result);
             return result;
         }
     }
 
     if (value->next() && !m_currentNextChain.contains(value.get())) {
+        const BindingRecorderScope recorderScope(m_bindingRecorders, nullptr);
         collectValuesFromNextChain(data, &result, name.toString(), value);
     } else {
-        QScriptValue parentObject;
-        if (foundInParent)
-            parentObject = data->evaluator->scriptValue(data->item->parent());
-        SVConverter converter(this, foundInParent ? &parentObject : &object, value, itemOfProperty,
-                              &name, data, &result);
-        converter.start();
+        const bool memoizable = m_valueCacheEnabled && !foundInParent
+                && isMemoizableBinding(value.get(), itemOfProperty, data->item);
+        if (memoizable && lookUpMemoizedBinding(value, data, &result)) {
+            if (debugProperties)
+                qDebug() << "[SC] memoized binding " << name << ": " << resultToString(result);
+        } else {
+            BindingRecorder recorder;
+            if (memoizable)
+                recorder.context = bindingContext(value.get(), data);
+            const BindingRecorderScope recorderScope(m_bindingRecorders,
+                                                     memoizable ? &recorder : nullptr);
+            QScriptValue parentObject;
+            if (foundInParent)
+                parentObject = data->evaluator->scriptValue(data->item->parent());
+            SVConverter converter(this, foundInParent ? &parentObject : &object, value,
+                                  itemOfProperty, &name, data, &result);
+            converter.start();
+            if (memoizable)
+                memoizeBinding(value, recorder, result);
+        }
 
         const PropertyDeclaration decl = data->item->propertyDeclaration(name.toString());
         convertToPropertyType(data->item, decl, value.get(), result);
@@ -711,6 +979,7 @@ QScriptValue EvaluatorScriptClass::property(const QScriptValue &object, const QS
         qDebug() << "[SC] cache miss " << name << ": " << resultToString(result);
     if (m_valueCacheEnabled)
         data->valueCache.insert(name, result);
+    recordRead(data->item, name.toString(), result);
     return result;
 }
 
@@ -718,47 +987,52 @@ class EvaluatorScriptClassPropertyIterator : public QScriptClassPropertyIterator
 {
 public:
     EvaluatorScriptClassPropertyIterator(const QScriptValue &object, EvaluationData *data)
-        : QScriptClassPropertyIterator(object), m_it(data->item->properties())
+        : QScriptClassPropertyIterator(object), m_properties(data->item->properties()),
+          m_pos(m_properties.constBegin()), m_current(m_properties.constEnd())
     {
     }
 
     bool hasNext() const override
     {
-        return m_it.hasNext();
+        return m_pos != m_properties.constEnd();
     }
 
     void next() override
     {
-        m_it.next();
+        m_current = m_pos++;
     }
 
     bool hasPrevious() const override
     {
-        return m_it.hasPrevious();
+        return m_pos != m_properties.constBegin();
     }
 
     void previous() override
     {
-        m_it.previous();
+        m_current = --m_pos;
     }
 
     void toFront() override
     {
-        m_it.toFront();
+        m_pos = m_properties.constBegin();
+        m_current = m_properties.constEnd();
     }
 
     void toBack() override
     {
-        m_it.toBack();
+        m_pos = m_properties.constEnd();
+        m_current = m_properties.constEnd();
     }
 
     QScriptString name() const override
     {
-        return object().engine()->toStringHandle(m_it.key());
+        return object().engine()->toStringHandle(m_current.key());
     }
 
 private:
-    QMapIterator<QString, ValuePtr> m_it;
+    const Item::PropertyMap m_properties;
+    Item::PropertyMap::const_iterator m_pos;
+    Item::PropertyMap::const_iterator m_current;
 };
 
 QScriptClassPropertyIterator *EvaluatorScriptClass::newIterator(const QScriptValue &object)
@@ -45,9 +45,15 @@
 
 #include <tools/set.h>
 
+#include <QtCore/qhash.h>
+#include <QtCore/qvariant.h>
+
 #include <QtScript/qscriptclass.h>
 
+#include <memory>
 #include <stack>
+#include <utility>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 class QScriptContext;
@@ -94,6 +100,86 @@ private:
                                const PropertyDeclaration& decl, const Value *value,
                                QScriptValue &v);
 
+    // Module property bindings that have not been overridden are shared between all products
+    // via the module prototype. The result of such a binding is remembered together with the
+    // property reads it performed, expressed relative to the module instance. If the same reads
+    // yield the same values for another instance, the result is re-used without evaluating
+    // the binding again.
+    struct MemoizedItem
+    {
+        enum Kind { Instance, ScopeChain, ModuleScopeItem, ProductModule, FileIdScope };
+        Kind kind = Instance;
+        int depth = 0;
+        QString name;
+
+        bool operator==(const MemoizedItem &other) const
+        {
+            return kind == other.kind && depth == other.depth && name == other.name;
+        }
+    };
+
+    struct MemoizedValue
+    {
+        enum Kind { Absent, Undefined, ItemReference, Data };
+        Kind kind = Absent;
+        MemoizedItem item;
+        QVariant data;
+
+        bool operator==(const MemoizedValue &other) const
+        {
+            return kind == other.kind && item == other.item && data == other.data;
+        }
+    };
+
+    struct MemoizedRead
+    {
+        MemoizedItem item;
+        QString propertyName;
+        MemoizedValue value;
+    };
+
+    struct MemoizedBinding
+    {
+        std::vector<MemoizedRead> reads;
+        MemoizedValue result;
+    };
+
+    // The value is tracked weakly, so that the entry becomes invalid when the item owning
+    // the value is destroyed, even if another value is later allocated at the same address.
+    struct MemoizedBindings
+    {
+        std::weak_ptr<const Value> value;
+        std::vector<MemoizedBinding> bindings;
+    };
+
+    struct BindingContext
+    {
+        const Item *moduleInstance = nullptr;
+        const Item *fileIdScope = nullptr;
+    };
+
+    struct BindingRecorder
+    {
+        BindingContext context;
+        std::vector<MemoizedRead> reads;
+        Set<std::pair<const Item *, QString>> seenReads;
+        bool valid = true;
+    };
+    friend class BindingRecorderScope;
+
+    static BindingContext bindingContext(const Value *value, const EvaluationData *data);
+    static const Item *resolveItem(const MemoizedItem &item, const BindingContext &context);
+    bool describeItem(const Item *item, const BindingContext &context,
+                      MemoizedItem *result) const;
+    bool describeValue(const QScriptValue &value, const BindingContext &context,
+                       MemoizedValue *result) const;
+    bool isPlainData(const QScriptValue &value, int depth = 0) const;
+    void recordRead(const Item *item, const QString &name, const QScriptValue &value);
+    bool lookUpMemoizedBinding(const ValuePtr &value, const EvaluationData *data,
+                               QScriptValue *result);
+    void memoizeBinding(const ValuePtr &value, BindingRecorder &recorder,
+                        const QScriptValue &result);
+
     struct QueryResult
     {
         QueryResult()
@@ -125,6 +211,8 @@ private:
     PropertyDependencies m_propertyDependencies;
     std::stack<QualifiedId> m_requestedProperties;
     QString m_pathPropertiesBaseDir;
+    QHash<const Value *, MemoizedBindings> m_memoizedBindings;
+    std::vector<BindingRecorder *> m_bindingRecorders;
 };
 
 } // namespace Internal
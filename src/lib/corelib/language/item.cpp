@@ -75,6 +75,32 @@ Item *Item::create(ItemPool *pool, ItemType type)
     return pool->allocateItem(type);
 }
 
+// Variant values and untouched builtin default values are never modified in place, so a clone
+// can share them with the original item. Assigning to the property later on replaces the value
+// in the respective item only.
+// The values of module instances are excluded, because the ModuleMerger links them into
+// next chains.
+static ValuePtr cloneValue(const Item *item, const ValuePtr &value)
+{
+    if (item->type() == ItemType::ModuleInstance || value->next() || value->definingItem())
+        return value->clone();
+    switch (value->type()) {
+    case Value::VariantValueType:
+        return value;
+    case Value::JSSourceValueType: {
+        const auto sourceValue = std::static_pointer_cast<JSSourceValue>(value);
+        if (sourceValue->isBuiltinDefaultValue() && !sourceValue->baseValue()
+                && sourceValue->alternatives().empty()) {
+            return value;
+        }
+        break;
+    }
+    default:
+        break;
+    }
+    return value->clone();
+}
+
 Item *Item::clone() const
 {
     Item *dup = create(pool(), type());
@@ -97,7 +123,7 @@ Item *Item::clone() const
 
     for (PropertyMap::const_iterator it = m_properties.constBegin(); it != m_properties.constEnd();
          ++it) {
-        dup->m_properties.insert(it.key(), it.value()->clone());
+        dup->m_properties.insert(it.key(), cloneValue(this, it.value()));
     }
 
     return dup;
@@ -47,10 +47,10 @@
 #include <parser/qmljsmemorypool_p.h>
 #include <tools/codelocation.h>
 #include <tools/error.h>
+#include <tools/flatmap.h>
 #include <tools/version.h>
 
 #include <QtCore/qlist.h>
-#include <QtCore/qmap.h>
 
 #include <vector>
 
@@ -84,8 +84,8 @@ public:
         VersionRange versionRange;
     };
     using Modules = std::vector<Module>;
-    using PropertyDeclarationMap = QMap<QString, PropertyDeclaration>;
-    using PropertyMap = QMap<QString, ValuePtr>;
+    using PropertyDeclarationMap = FlatMap<QString, PropertyDeclaration>;
+    using PropertyMap = FlatMap<QString, ValuePtr>;
 
     static Item *create(ItemPool *pool, ItemType type);
     Item *clone() const;
@@ -64,7 +64,6 @@
 
 #include <QtCore/qcryptographichash.h>
 #include <QtCore/qdir.h>
-#include <QtCore/qdiriterator.h>
 #include <QtCore/qmap.h>
 
 #include <QtScript/qscriptvalue.h>
@@ -709,15 +708,27 @@ void TopLevelProject::cleanupModuleProviderOutput()
  */
 
 Set<QString> SourceWildCards::expandPatterns(const GroupConstPtr &group,
-                                              const QString &baseDir, const QString &buildDir)
-{
-    Set<QString> files = expandPatterns(group, patterns, baseDir, buildDir);
-    files -= expandPatterns(group, excludePatterns, baseDir, buildDir);
+                                              const QString &baseDir, const QString &buildDir,
+                                              DirectorySnapshot &snapshot)
+{
+    dirTimeStamps.clear();
+    Set<QString> files = expandPatterns(group, patterns, baseDir, buildDir, snapshot);
+    files -= expandPatterns(group, excludePatterns, baseDir, buildDir, snapshot);
+    std::sort(dirTimeStamps.begin(), dirTimeStamps.end(),
+              [](const std::pair<QString, FileTime> &p1, const std::pair<QString, FileTime> &p2) {
+        return p1.first < p2.first;
+    });
+    dirTimeStamps.erase(std::unique(dirTimeStamps.begin(), dirTimeStamps.end(),
+                                    [](const std::pair<QString, FileTime> &p1,
+                                       const std::pair<QString, FileTime> &p2) {
+        return p1.first == p2.first;
+    }), dirTimeStamps.end());
     return files;
 }
 
 Set<QString> SourceWildCards::expandPatterns(const GroupConstPtr &group,
-        const QStringList &patterns, const QString &baseDir, const QString &buildDir)
+        const QStringList &patterns, const QString &baseDir, const QString &buildDir,
+        DirectorySnapshot &snapshot)
 {
     Set<QString> files;
     QString expandedPrefix = group->prefix;
@@ -736,18 +747,22 @@ Set<QString> SourceWildCards::expandPatterns(const GroupConstPtr &group,
             } else {
                 rootDir = QLatin1Char('/');
             }
-            expandPatterns(files, group, parts, rootDir, buildDir);
+            expandPatterns(files, group, parts, rootDir, buildDir, snapshot);
         } else {
-            expandPatterns(files, group, parts, baseDir, buildDir);
+            expandPatterns(files, group, parts, baseDir, buildDir, snapshot);
         }
     }
 
     return files;
 }
 
+// Matches the parts of a pattern against the directory snapshot. The rules are those of
+// a QDirIterator with case-insensitive name filters. Hidden entries only match directory names
+// given literally, and "**" does not descend into hidden directories or symbolic links.
 void SourceWildCards::expandPatterns(Set<QString> &result, const GroupConstPtr &group,
                                      const QStringList &parts,
-                                     const QString &baseDir, const QString &buildDir)
+                                     const QString &baseDir, const QString &buildDir,
+                                     DirectorySnapshot &snapshot)
 {
     // People might build directly in the project source directory. This is okay, since
     // we keep the build data in a "container" directory. However, we must make sure we don't
@@ -755,8 +770,6 @@ void SourceWildCards::expandPatterns(Set<QString> &result, const GroupConstPtr &
     if (baseDir.startsWith(buildDir))
         return;
 
-    dirTimeStamps.emplace_back(baseDir, FileInfo(baseDir).lastModified());
-
     QStringList changed_parts = parts;
     bool recursive = false;
     QString part = changed_parts.takeFirst();
@@ -775,33 +788,40 @@ void SourceWildCards::expandPatterns(Set<QString> &result, const GroupConstPtr &
     const bool isDir = !changed_parts.empty();
 
     const QString &filePattern = part;
-    const QDirIterator::IteratorFlags itFlags = recursive
-            ? QDirIterator::Subdirectories
-            : QDirIterator::NoIteratorFlags;
-    QDir::Filters itFilters = isDir
-            ? QDir::Dirs
-            : QDir::Files | QDir::System
-              | QDir::Dirs; // This one is needed to get symbolic links to directories
-
-    if (isDir && !FileInfo::isPattern(filePattern))
-        itFilters |= QDir::Hidden;
-    if (filePattern != StringConstants::dotDot() && filePattern != StringConstants::dot())
-        itFilters |= QDir::NoDotAndDotDot;
-
-    QDirIterator it(baseDir, QStringList(filePattern), itFilters, itFlags);
-    while (it.hasNext()) {
-        const QString filePath = it.next();
-        const QString parentDir = it.fileInfo().dir().path();
-        if (parentDir.startsWith(buildDir))
-            continue; // See above.
-        if (!isDir && it.fileInfo().isDir() && !it.fileInfo().isSymLink())
+    const bool includeHidden = isDir && !FileInfo::isPattern(filePattern);
+    const bool isDotOrDotDot = filePattern == StringConstants::dot()
+            || filePattern == StringConstants::dotDot();
+    const QRegularExpression nameFilter(
+                QRegularExpression::wildcardToRegularExpression(filePattern),
+                QRegularExpression::CaseInsensitiveOption);
+
+    const std::vector<QString> dirPaths = recursive
+            ? snapshot.subTree(baseDir, buildDir, includeHidden)
+            : std::vector<QString>{baseDir};
+    for (const QString &dirPath : dirPaths) {
+        const DirectorySnapshot::Directory dir = snapshot.directory(dirPath);
+        dirTimeStamps.emplace_back(dirPath, dir.lastModified);
+        if (isDotOrDotDot) {
+            if (isDir && dir.lastModified.isValid()) {
+                expandPatterns(result, group, changed_parts,
+                               DirectorySnapshot::filePath(dirPath, filePattern), buildDir,
+                               snapshot);
+            }
             continue;
-        if (isDir) {
-            expandPatterns(result, group, changed_parts, filePath, buildDir);
-        } else {
-            if (parentDir != baseDir)
-                dirTimeStamps.emplace_back(parentDir, FileInfo(baseDir).lastModified());
-            result += QDir::cleanPath(filePath);
+        }
+        for (const DirectorySnapshot::Entry &entry : dir.entries) {
+            if ((entry.flags & DirectorySnapshot::IsHidden) && !includeHidden)
+                continue;
+            if (!nameFilter.match(entry.name).hasMatch())
+                continue;
+            const QString filePath = DirectorySnapshot::filePath(dirPath, entry.name);
+            if (isDir) {
+                if (entry.flags & DirectorySnapshot::IsDirectory)
+                    expandPatterns(result, group, changed_parts, filePath, buildDir, snapshot);
+            } else if (!(entry.flags & DirectorySnapshot::IsDirectory)
+                       || (entry.flags & DirectorySnapshot::IsSymLink)) {
+                result += QDir::cleanPath(filePath);
+            }
         }
     }
 }
@@ -49,6 +49,7 @@
 
 #include <buildgraph/forward_decls.h>
 #include <tools/codelocation.h>
+#include <tools/directorysnapshot.h>
 #include <tools/filetime.h>
 #include <tools/joblimits.h>
 #include <tools/persistence.h>
@@ -251,7 +252,7 @@ class SourceWildCards
 {
 public:
     Set<QString> expandPatterns(const GroupConstPtr &group, const QString &baseDir,
-                                 const QString &buildDir);
+                                 const QString &buildDir, DirectorySnapshot &snapshot);
 
     const ResolvedGroup *group = nullptr;       // The owning group.
     QStringList patterns;
@@ -266,10 +267,11 @@ public:
 
 private:
     Set<QString> expandPatterns(const GroupConstPtr &group, const QStringList &patterns,
-                                 const QString &baseDir, const QString &buildDir);
+                                 const QString &baseDir, const QString &buildDir,
+                                 DirectorySnapshot &snapshot);
     void expandPatterns(Set<QString> &result, const GroupConstPtr &group,
                         const QStringList &parts, const QString &baseDir,
-                        const QString &buildDir);
+                        const QString &buildDir, DirectorySnapshot &snapshot);
 };
 
 class QBS_AUTOTEST_EXPORT ResolvedGroup
@@ -694,6 +696,7 @@ public:
     QHash<QString, bool> fileExistsResults; // Results of calls to "File.exists()".
     QHash<std::pair<QString, quint32>, QStringList> directoryEntriesResults; // Results of calls to "File.directoryEntries()".
     QHash<QString, FileTime> fileLastModifiedResults; // Results of calls to "File.lastModified()".
+    DirectorySnapshot directorySnapshot; // Directory listings used for wildcard expansion.
     std::unique_ptr<ProjectBuildData> buildData;
     BuildGraphLocker *bgLocker; // This holds the system-wide build graph file lock.
     bool locked; // This is the API-level lock for the project instance.
@@ -724,7 +727,7 @@ private:
                                      directoryEntriesResults, fileLastModifiedResults, environment,
                                      probes, profileConfigs, overriddenValues, buildSystemFiles,
                                      lastStartResolveTime, lastEndResolveTime, warningsEncountered,
-                                     buildData, moduleProviderInfo);
+                                     buildData, moduleProviderInfo, directorySnapshot);
     }
     void load(PersistentPool &pool) override;
     void store(PersistentPool &pool) override;
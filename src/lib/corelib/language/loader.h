@@ -42,6 +42,7 @@
 #include "forward_decls.h"
 #include "moduleproviderinfo.h"
 #include <logging/logger.h>
+#include <tools/directorysnapshot.h>
 #include <tools/filetime.h>
 
 #include <QtCore/qstringlist.h>
@@ -66,6 +67,7 @@ public:
     void setLastResolveTime(const FileTime &time) { m_lastResolveTime = time; }
     void setStoredProfiles(const QVariantMap &profiles);
     void setStoredModuleProviderInfo(const ModuleProviderInfoList &providerInfo);
+    void setStoredDirectorySnapshot(const DirectorySnapshot &snapshot);
     TopLevelProjectPtr loadProject(const SetupProjectParameters &parameters);
 
     static void setupProjectFilePath(SetupProjectParameters &parameters);
@@ -78,6 +80,7 @@ private:
     std::vector<ProbeConstPtr> m_oldProjectProbes;
     QHash<QString, std::vector<ProbeConstPtr>> m_oldProductProbes;
     ModuleProviderInfoList m_storedModuleProviderInfo;
+    DirectorySnapshot m_storedDirectorySnapshot;
     QVariantMap m_storedProfiles;
     FileTime m_lastResolveTime;
 };
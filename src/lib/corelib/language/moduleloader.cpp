@@ -1810,7 +1810,7 @@ static void mergeProperty(Item *dst, const QString &name, const ValuePtr &value)
         const ItemValueConstPtr itemValue = std::static_pointer_cast<ItemValue>(value);
         const Item * const valueItem = itemValue->item();
         Item * const subItem = dst->itemProperty(name, itemValue)->item();
-        for (QMap<QString, ValuePtr>::const_iterator it = valueItem->properties().constBegin();
+        for (Item::PropertyMap::const_iterator it = valueItem->properties().constBegin();
                 it != valueItem->properties().constEnd(); ++it)
             mergeProperty(subItem, it.key(), it.value());
     } else {
@@ -2042,7 +2042,7 @@ bool ModuleLoader::mergeExportItems(const ProductContext &productContext)
             }
             merged->setPropertyDeclaration(newDecl.name(), newDecl);
         }
-        for (QMap<QString, ValuePtr>::const_iterator it = exportItem->properties().constBegin();
+        for (Item::PropertyMap::const_iterator it = exportItem->properties().constBegin();
                 it != exportItem->properties().constEnd(); ++it) {
             mergeProperty(merged, it.key(), it.value());
         }
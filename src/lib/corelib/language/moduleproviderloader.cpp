@@ -55,11 +55,149 @@
 #include <tools/jsliterals.h>
 #include <tools/stringconstants.h>
 
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qdiriterator.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qjsonarray.h>
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qstandardpaths.h>
+#include <QtCore/qtemporarydir.h>
 #include <QtCore/qtemporaryfile.h>
 
 namespace qbs {
 namespace Internal {
 
+static QString cachedSearchPathsFileName() { return QStringLiteral("searchpaths.json"); }
+static QString cachedModulesDirName() { return QStringLiteral("modules"); }
+
+static QString moduleProviderCacheBaseDir(const QString &settingsDir)
+{
+    const QString baseDir = !settingsDir.isEmpty()
+            ? settingsDir + QStringLiteral("/cache")
+            : QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation)
+              + QStringLiteral("/qbs");
+    return baseDir + QStringLiteral("/module-providers");
+}
+
+// The cache entry is keyed by everything that can influence the provider's output:
+// The provider sources themselves, its configuration and the provider-supplied cache key.
+static QString moduleProviderCacheDir(const QString &settingsDir, const QualifiedId &name,
+                                      const QString &providerFile, const QVariantMap &config,
+                                      const QString &cacheKey)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QByteArrayLiteral(QBS_VERSION));
+    hash.addData(providerFile.toUtf8());
+    QStringList providerSources;
+    QDirIterator it(FileInfo::path(providerFile), QDir::Files | QDir::Hidden,
+                    QDirIterator::Subdirectories);
+    while (it.hasNext())
+        providerSources << it.next();
+    providerSources.sort();
+    for (const QString &filePath : qAsConst(providerSources)) {
+        hash.addData(filePath.toUtf8());
+        hash.addData(QByteArray::number(
+                         QFileInfo(filePath).lastModified().toMSecsSinceEpoch()));
+    }
+    hash.addData(QJsonDocument::fromVariant(config).toJson(QJsonDocument::Compact));
+    hash.addData(cacheKey.toUtf8());
+    return moduleProviderCacheBaseDir(settingsDir) + QLatin1Char('/') + name.toString()
+            + QLatin1Char('/') + QString::fromLatin1(hash.result().toHex());
+}
+
+// Entries only ever appear in the cache by renaming a fully written directory,
+// so an entry whose search paths file can be read is complete.
+static bool readCachedSearchPaths(const QString &cacheDir, QJsonArray *relativePaths)
+{
+    QFile searchPathsFile(cacheDir + QLatin1Char('/') + cachedSearchPathsFileName());
+    if (!searchPathsFile.open(QIODevice::ReadOnly))
+        return false;
+    const QJsonDocument doc = QJsonDocument::fromJson(searchPathsFile.readAll());
+    if (!doc.isArray())
+        return false;
+    *relativePaths = doc.array();
+    return true;
+}
+
+static bool restoreFromCache(const QString &cacheDir, const QString &outputBaseDir,
+                             QStringList *searchPaths)
+{
+    QJsonArray relativePaths;
+    if (!readCachedSearchPaths(cacheDir, &relativePaths))
+        return false;
+    QString errorMessage;
+    if (FileInfo::exists(outputBaseDir)
+            && !removeDirectoryWithContents(outputBaseDir, &errorMessage)) {
+        qCDebug(lcModuleLoader) << "cannot clear module provider output:" << errorMessage;
+        return false;
+    }
+    const QString cachedModulesDir = cacheDir + QLatin1Char('/') + cachedModulesDirName();
+    if (FileInfo::exists(cachedModulesDir)
+            && !copyFileRecursion(cachedModulesDir, outputBaseDir, true, true, &errorMessage)) {
+        qCDebug(lcModuleLoader) << "cannot restore module provider output:" << errorMessage;
+        return false;
+    }
+    for (const QJsonValue &p : qAsConst(relativePaths))
+        searchPaths->push_back(QDir::cleanPath(outputBaseDir + QLatin1Char('/') + p.toString()));
+    return true;
+}
+
+// The entry is assembled in a temporary directory next to its final location and then
+// renamed into place, so other qbs processes never see a partially written entry.
+static void storeInCache(const QString &cacheDir, const QString &outputBaseDir,
+                         const QStringList &searchPaths)
+{
+    QDir::root().mkpath(FileInfo::path(cacheDir));
+    QTemporaryDir tempDir(cacheDir + QStringLiteral(".tmp-XXXXXX"));
+    if (!tempDir.isValid()) {
+        qCDebug(lcModuleLoader) << "cannot create temporary module provider cache entry:"
+                                << tempDir.errorString();
+        return;
+    }
+    QString errorMessage;
+    if (FileInfo::exists(outputBaseDir)
+            && !copyFileRecursion(outputBaseDir,
+                                  tempDir.path() + QLatin1Char('/') + cachedModulesDirName(),
+                                  true, true, &errorMessage)) {
+        qCDebug(lcModuleLoader) << "cannot cache module provider output:" << errorMessage;
+        return;
+    }
+    const QDir outputDir(outputBaseDir);
+    QJsonArray relativePaths;
+    for (const QString &p : searchPaths)
+        relativePaths.append(outputDir.relativeFilePath(p));
+    QFile searchPathsFile(tempDir.path() + QLatin1Char('/') + cachedSearchPathsFileName());
+    if (!searchPathsFile.open(QIODevice::WriteOnly)
+            || searchPathsFile.write(QJsonDocument(relativePaths).toJson()) == -1
+            || !searchPathsFile.flush()) {
+        qCDebug(lcModuleLoader) << "cannot write module provider cache entry:"
+                                << searchPathsFile.errorString();
+        return;
+    }
+    searchPathsFile.close();
+
+    if (FileInfo::exists(cacheDir)) {
+        // Another process may have stored the same entry in the meantime, which is fine.
+        // Anything else is a left-over that cannot be used.
+        QJsonArray existingPaths;
+        if (readCachedSearchPaths(cacheDir, &existingPaths))
+            return;
+        if (!removeDirectoryWithContents(cacheDir, &errorMessage)) {
+            qCDebug(lcModuleLoader) << "cannot clear module provider cache entry:"
+                                    << errorMessage;
+            return;
+        }
+    }
+    if (!QDir::root().rename(tempDir.path(), cacheDir)) {
+        qCDebug(lcModuleLoader) << "cannot move module provider cache entry into place:"
+                                << cacheDir;
+        return;
+    }
+    tempDir.setAutoRemove(false);
+}
+
 ModuleProviderLoader::ModuleProviderLoader(ItemReader *reader, Evaluator *evaluator)
     : m_reader(reader)
     , m_evaluator(evaluator)
@@ -281,7 +419,25 @@ QStringList ModuleProviderLoader::getProviderSearchPaths(
         providerItem->setProperty(it.key(), VariantValue::create(it.value()));
     }
     EvalContextSwitcher contextSwitcher(m_evaluator->engine(), EvalContext::ModuleProvider);
-    return m_evaluator->stringListValue(providerItem, QStringLiteral("searchPaths"));
+    const QString cacheKey = m_evaluator->stringValue(providerItem, QStringLiteral("cacheKey"));
+    if (cacheKey.isEmpty())
+        return m_evaluator->stringListValue(providerItem, QStringLiteral("searchPaths"));
+
+    // The provider has declared its output to be fully determined by the cache key,
+    // so we can skip running it if we have seen the same key before.
+    const QString outputBaseDir
+            = m_evaluator->stringValue(providerItem, QStringLiteral("outputBaseDir"));
+    const QString cacheDir = moduleProviderCacheDir(m_parameters.settingsDirectory(), name,
+                                                    providerFile, moduleConfig, cacheKey);
+    QStringList searchPaths;
+    if (restoreFromCache(cacheDir, outputBaseDir, &searchPaths)) {
+        qCDebug(lcModuleLoader) << "re-using cached output of module provider" << name
+                                << "from" << cacheDir;
+        return searchPaths;
+    }
+    searchPaths = m_evaluator->stringListValue(providerItem, QStringLiteral("searchPaths"));
+    storeInCache(cacheDir, outputBaseDir, searchPaths);
+    return searchPaths;
 }
 
 } // namespace Internal
@@ -134,6 +134,11 @@ void ProjectResolver::setProgressObserver(ProgressObserver *observer)
     m_progressObserver = observer;
 }
 
+void ProjectResolver::setStoredDirectorySnapshot(const DirectorySnapshot &snapshot)
+{
+    m_directorySnapshot.setPreviousSnapshot(snapshot);
+}
+
 static void checkForDuplicateProductNames(const TopLevelProjectConstPtr &project)
 {
     const std::vector<ResolvedProductPtr> allProducts = project->allProducts();
@@ -256,6 +261,8 @@ TopLevelProjectPtr ProjectResolver::resolveTopLevelProject()
     project->fileExistsResults = m_engine->fileExistsResults();
     project->directoryEntriesResults = m_engine->directoryEntriesResults();
     project->fileLastModifiedResults = m_engine->fileLastModifiedResults();
+    m_directorySnapshot.clearPreviousSnapshot();
+    project->directorySnapshot = m_directorySnapshot;
     project->environment = m_engine->environment();
     project->buildSystemFiles.unite(m_engine->imports());
     makeSubProjectNamesUniqe(project);
@@ -819,7 +826,8 @@ void ProjectResolver::resolveGroupFully(Item *item, ProjectResolver::ProjectCont
         wildcards->patterns = patterns;
         const Set<QString> files = wildcards->expandPatterns(group,
                 FileInfo::path(item->file()->filePath()),
-                projectContext->project->topLevelProject()->buildDirectory);
+                projectContext->project->topLevelProject()->buildDirectory,
+                m_directorySnapshot);
         for (const QString &fileName : files)
             createSourceArtifact(m_productContext->product, fileName, group, true, filesLocation,
                                  &m_productContext->sourceArtifactLocations, &fileError);
@@ -1283,7 +1291,7 @@ void ProjectResolver::resolveRuleArtifact(const RulePtr &rule, Item *item)
 
     QualifiedIdSet seenBindings;
     for (Item *obj = item; obj; obj = obj->prototype()) {
-        for (QMap<QString, ValuePtr>::const_iterator it = obj->properties().constBegin();
+        for (Item::PropertyMap::const_iterator it = obj->properties().constBegin();
              it != obj->properties().constEnd(); ++it)
         {
             if (it.value()->type() != Value::ItemValueType)
@@ -1300,7 +1308,7 @@ void ProjectResolver::resolveRuleArtifactBinding(const RuleArtifactPtr &ruleArti
                                                  const QStringList &namePrefix,
                                                  QualifiedIdSet *seenBindings)
 {
-    for (QMap<QString, ValuePtr>::const_iterator it = item->properties().constBegin();
+    for (Item::PropertyMap::const_iterator it = item->properties().constBegin();
          it != item->properties().constEnd(); ++it)
     {
         const QStringList name = QStringList(namePrefix) << it.key();
@@ -1719,7 +1727,7 @@ QVariantMap ProjectResolver::evaluateProperties(const Item *item, const Item *pr
     AccumulatingTimer propEvalTimer(m_setupParams.logElapsedTime()
                                     ? &m_elapsedTimeAllPropEval : nullptr);
     QVariantMap result = tmplt;
-    for (QMap<QString, ValuePtr>::const_iterator it = propertiesContainer->properties().begin();
+    for (Item::PropertyMap::const_iterator it = propertiesContainer->properties().begin();
          it != propertiesContainer->properties().end(); ++it) {
         checkCancelation();
         evaluateProperty(item, it.key(), it.value(), result, checkErrors);
@@ -46,6 +46,7 @@
 #include "qualifiedid.h"
 
 #include <logging/logger.h>
+#include <tools/directorysnapshot.h>
 #include <tools/set.h>
 
 #include <QtCore/qhash.h>
@@ -72,6 +73,7 @@ public:
     ~ProjectResolver();
 
     void setProgressObserver(ProgressObserver *observer);
+    void setStoredDirectorySnapshot(const DirectorySnapshot &snapshot);
     TopLevelProjectPtr resolve();
 
     static void applyFileTaggers(const SourceArtifactPtr &artifact,
@@ -193,6 +195,7 @@ private:
     Set<CodeLocation> m_groupLocationWarnings;
     std::vector<std::pair<ResolvedProductPtr, Item *>> m_productExportInfo;
     std::vector<ErrorInfo> m_queuedErrors;
+    DirectorySnapshot m_directorySnapshot;
     qint64 m_elapsedTimeModPropEval = 0;
     qint64 m_elapsedTimeAllPropEval = 0;
     qint64 m_elapsedTimeGroups = 0;
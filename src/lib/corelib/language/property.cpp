@@ -39,9 +39,20 @@
 
 #include "property.h"
 
+#include "propertymapinternal.h"
+
 namespace qbs {
 namespace Internal {
 
+quint64 Property::valueFingerprint() const
+{
+    if (!m_hasValueFingerprint) {
+        m_valueFingerprint = variantFingerprint(value);
+        m_hasValueFingerprint = true;
+    }
+    return m_valueFingerprint;
+}
+
 bool operator<(const Property &p1, const Property &p2)
 {
     int cmpResult = QString::compare(p1.productName, p2.productName);
@@ -77,14 +77,26 @@ public:
 
     template<PersistentPool::OpType opType> void completeSerializationOp(PersistentPool &pool)
     {
-        pool.serializationOp<opType>(productName, moduleName, propertyName, value, kind);
+        if constexpr (opType == PersistentPool::Store)
+            valueFingerprint();
+        pool.serializationOp<opType>(productName, moduleName, propertyName, value, kind,
+                                     m_valueFingerprint);
+        m_hasValueFingerprint = true;
     }
 
+    // A stable hash of the value, see variantFingerprint(). Computed on first use and
+    // stored in the build graph, so that change tracking can compare integers.
+    quint64 valueFingerprint() const;
+
     QString productName; // In case of kind == PropertyInProject, this is the project name.
     QString moduleName;
     QString propertyName;
     QVariant value;
     Kind kind;
+
+private:
+    mutable quint64 m_valueFingerprint = 0;
+    mutable bool m_hasValueFingerprint = false;
 };
 
 inline bool operator==(const Property &p1, const Property &p2)
@@ -81,6 +81,86 @@ QVariant PropertyMapInternal::property(const QStringList &name) const
 void PropertyMapInternal::setValue(const QVariantMap &map)
 {
     m_value = map;
+    m_hasFingerprint = false;
+    m_moduleValueFingerprints.clear();
+}
+
+// The fingerprint ends up in the build graph, so it must not depend on per-process hash seeds.
+// Hence we use FNV-1a over the type ids, keys and values instead of qHash() or std::hash.
+// Containers contribute their element count, so that differently nested values with the same
+// sequence of leaves, such as [["a"], "b"] and [["a", "b"]], get different fingerprints.
+static void addToFingerprint(quint64 &hash, const void *data, size_t size)
+{
+    const auto bytes = static_cast<const unsigned char *>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+}
+
+static void addToFingerprint(quint64 &hash, const QString &s)
+{
+    const int size = s.size();
+    addToFingerprint(hash, &size, sizeof size);
+    addToFingerprint(hash, s.constData(), size * sizeof(QChar));
+}
+
+static void addToFingerprint(quint64 &hash, const QVariant &v)
+{
+    const int type = v.userType();
+    addToFingerprint(hash, &type, sizeof type);
+    switch (type) {
+    case QMetaType::QVariantMap: {
+        const QVariantMap map = v.toMap();
+        const int size = map.size();
+        addToFingerprint(hash, &size, sizeof size);
+        for (auto it = map.cbegin(); it != map.cend(); ++it) {
+            addToFingerprint(hash, it.key());
+            addToFingerprint(hash, it.value());
+        }
+        break;
+    }
+    case QMetaType::QVariantList:
+    case QMetaType::QStringList: {
+        const QVariantList list = v.toList();
+        const int size = list.size();
+        addToFingerprint(hash, &size, sizeof size);
+        for (const QVariant &element : list)
+            addToFingerprint(hash, element);
+        break;
+    }
+    default:
+        addToFingerprint(hash, v.toString());
+        break;
+    }
+}
+
+quint64 variantFingerprint(const QVariant &value)
+{
+    quint64 hash = 0xcbf29ce484222325ULL;
+    addToFingerprint(hash, value);
+    return hash;
+}
+
+quint64 PropertyMapInternal::fingerprint() const
+{
+    if (!m_hasFingerprint) {
+        m_fingerprint = variantFingerprint(m_value);
+        m_hasFingerprint = true;
+    }
+    return m_fingerprint;
+}
+
+quint64 PropertyMapInternal::moduleValueFingerprint(const QString &moduleName,
+                                                    const QString &key) const
+{
+    const QString cacheKey = moduleName + QLatin1Char('.') + key;
+    auto it = m_moduleValueFingerprints.find(cacheKey);
+    if (it == m_moduleValueFingerprints.end()) {
+        it = m_moduleValueFingerprints.insert(cacheKey,
+                                              variantFingerprint(moduleProperty(moduleName, key)));
+    }
+    return it.value();
 }
 
 QVariant moduleProperty(const QVariantMap &properties, const QString &moduleName,
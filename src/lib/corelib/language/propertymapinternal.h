@@ -43,6 +43,7 @@
 #include "forward_decls.h"
 #include <tools/persistence.h>
 #include <tools/qbs_export.h>
+#include <QtCore/qhash.h>
 #include <QtCore/qvariant.h>
 
 namespace qbs {
@@ -61,6 +62,12 @@ public:
     QVariant property(const QStringList &name) const;
     void setValue(const QVariantMap &value);
 
+    // A hash of the complete value. Equal maps have equal fingerprints.
+    quint64 fingerprint() const;
+
+    // The fingerprint of a single module property value, cached until the next setValue().
+    quint64 moduleValueFingerprint(const QString &moduleName, const QString &key) const;
+
     template<PersistentPool::OpType opType> void completeSerializationOp(PersistentPool &pool)
     {
         pool.serializationOp<opType>(m_value);
@@ -73,6 +80,9 @@ private:
     PropertyMapInternal(const PropertyMapInternal &other);
 
     QVariantMap m_value;
+    mutable quint64 m_fingerprint = 0;
+    mutable bool m_hasFingerprint = false;
+    mutable QHash<QString, quint64> m_moduleValueFingerprints;
 };
 
 inline bool operator==(const PropertyMapInternal &lhs, const PropertyMapInternal &rhs)
@@ -80,6 +90,9 @@ inline bool operator==(const PropertyMapInternal &lhs, const PropertyMapInternal
     return lhs.m_value == rhs.m_value;
 }
 
+// A hash of the value that is stable across processes, so it can be stored in the build graph.
+quint64 QBS_AUTOTEST_EXPORT variantFingerprint(const QVariant &value);
+
 QVariant QBS_AUTOTEST_EXPORT moduleProperty(const QVariantMap &properties,
                                             const QString &moduleName,
                                             const QString &key, bool *isPresent = nullptr);
@@ -134,6 +134,9 @@ ScriptEngine::~ScriptEngine()
     if (m_elapsedTimeImporting != -1) {
         m_logger.qbsLog(LoggerInfo, true) << Tr::tr("Setting up imports took %1.")
                                              .arg(elapsedTimeString(m_elapsedTimeImporting));
+        m_logger.qbsLog(LoggerInfo, true) << Tr::tr("Re-used %n memoized module property "
+                                                    "binding(s).", nullptr,
+                                                    m_memoizedBindingHits);
     }
     delete m_modulePropertyScriptClass;
     delete m_productPropertyScriptClass;
@@ -289,6 +292,26 @@ QVariant ScriptEngine::retrieveFromPropertyCache(const QString &moduleName,
     return m_propertyCache.value(PropertyCacheKey(moduleName, propertyName, propertyMap));
 }
 
+void ScriptEngine::addToDerivedValueCache(const QString &key, const Artifact *artifact,
+                                          const DerivedPropertyValue &value)
+{
+    m_derivedValueCache.insert(PropertyCacheKey(key, artifact->product->uniqueName(),
+                                                artifact->properties), value);
+}
+
+QVariant ScriptEngine::retrieveFromDerivedValueCache(const QString &key, const Artifact *artifact)
+{
+    const auto it = m_derivedValueCache.constFind(
+                PropertyCacheKey(key, artifact->product->uniqueName(), artifact->properties));
+    if (it == m_derivedValueCache.constEnd())
+        return {};
+    for (const Property &p : it->productProperties)
+        addPropertyRequestedInScript(p);
+    for (const Property &p : it->artifactProperties)
+        addPropertyRequestedFromArtifact(artifact, p);
+    return it->value;
+}
+
 void ScriptEngine::defineProperty(QScriptValue &object, const QString &name,
                                   const QScriptValue &descriptor)
 {
@@ -173,6 +173,10 @@ public:
 
     void enableProfiling(bool enable);
 
+    // The number of module property bindings for which a memoized result was re-used.
+    void addMemoizedBindingHit() { ++m_memoizedBindingHits; }
+    int memoizedBindingHits() const { return m_memoizedBindingHits; }
+
     void setPropertyCacheEnabled(bool enable) { m_propertyCacheEnabled = enable; }
     bool isPropertyCacheEnabled() const { return m_propertyCacheEnabled; }
     void addToPropertyCache(const QString &moduleName, const QString &propertyName,
@@ -180,6 +184,19 @@ public:
     QVariant retrieveFromPropertyCache(const QString &moduleName, const QString &propertyName,
                                        const PropertyMapConstPtr &propertyMap);
 
+    // A value that native extension code derived from the module properties of an artifact
+    // and its product, along with the properties it was derived from. These get reported
+    // as requested whenever the value is re-used for an artifact with the same properties.
+    struct DerivedPropertyValue
+    {
+        QVariant value;
+        std::vector<Property> productProperties;
+        std::vector<Property> artifactProperties;
+    };
+    void addToDerivedValueCache(const QString &key, const Artifact *artifact,
+                                const DerivedPropertyValue &value);
+    QVariant retrieveFromDerivedValueCache(const QString &key, const Artifact *artifact);
+
     void defineProperty(QScriptValue &object, const QString &name, const QScriptValue &descriptor);
     void setObservedProperty(QScriptValue &object, const QString &name, const QScriptValue &value);
     void unobserveProperties();
@@ -327,6 +344,7 @@ private:
     bool m_propertyCacheEnabled;
     bool m_active;
     QHash<PropertyCacheKey, QVariant> m_propertyCache;
+    QHash<PropertyCacheKey, DerivedPropertyValue> m_derivedValueCache;
     PropertySet m_propertiesRequestedInScript;
     QHash<QString, PropertySet> m_propertiesRequestedFromArtifact;
     Logger &m_logger;
@@ -346,6 +364,7 @@ private:
     QScriptValue m_consoleObject;
     QScriptValue m_cancelationError;
     qint64 m_elapsedTimeImporting = -1;
+    int m_memoizedBindingHits = 0;
     bool m_usesIo = false;
     EvalContext m_evalContext;
     std::vector<ResourceAcquiringScriptObject *> m_resourceAcquiringScriptObjects;
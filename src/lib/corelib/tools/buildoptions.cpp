@@ -74,6 +74,9 @@ public:
     bool removeExistingInstallation;
     bool onlyExecuteRules;
     bool jobLimitsFromProjectTakePrecedence = false;
+    bool changedFilesComplete = false;
+    bool provideMakeJobServer = false;
+    bool adaptiveJobScheduling = false;
 };
 
 } // namespace Internal
@@ -115,6 +118,28 @@ void BuildOptions::setChangedFiles(const QStringList &changedFiles)
     d->changedFiles = changedFiles;
 }
 
+/*!
+ * \brief Returns true if the list of changed files is known to be complete.
+ * The default is false.
+ * \sa setChangedFilesComplete
+ */
+bool BuildOptions::changedFilesComplete() const
+{
+    return d->changedFilesComplete;
+}
+
+/*!
+ * \brief If \a complete is \c true, qbs assumes that no file other than the ones returned by
+ *        \c changedFiles() has changed since the last build, even if that list is empty.
+ * The stored timestamps of all other source files and file dependencies are then used without
+ * consulting the file system. Set this only if the list comes from a reliable source, such as
+ * a file system watcher that has been running without interruption since the last build.
+ */
+void BuildOptions::setChangedFilesComplete(bool complete)
+{
+    d->changedFilesComplete = complete;
+}
+
 /*!
  * \brief The list of files to consider.
  * \sa setFilesToConsider.
@@ -224,6 +249,49 @@ void BuildOptions::setProjectJobLimitsTakePrecedence(bool toggle)
     d->jobLimitsFromProjectTakePrecedence = toggle;
 }
 
+/*!
+ * \brief Returns true if processes run by commands get access to qbs' job tokens
+ *        via the GNU make jobserver protocol.
+ * The default is false.
+ */
+bool BuildOptions::provideMakeJobServer() const
+{
+    return d->provideMakeJobServer;
+}
+
+/*!
+ * \brief If \a provide is \c true, a GNU make compatible job server is made available to
+ *        processes run by commands, via the \c MAKEFLAGS environment variable.
+ * A \c make or other build tool called from a command then shares the job limit with qbs.
+ * If qbs itself runs under a job server, that one is passed on instead.
+ * This option is only supported on Unix hosts.
+ */
+void BuildOptions::setProvideMakeJobServer(bool provide)
+{
+    d->provideMakeJobServer = provide;
+}
+
+/*!
+ * \brief Returns true iff the start of new jobs depends on the memory situation and load
+ *        of the host.
+ * The default is false.
+ */
+bool BuildOptions::adaptiveJobScheduling() const
+{
+    return d->adaptiveJobScheduling;
+}
+
+/*!
+ * \brief If \a enabled is \c true, qbs records the peak memory usage of the commands in each
+ *        job pool and holds back jobs of memory-hungry pools while the host is running low
+ *        on memory or is overloaded. Jobs that are known to be cheap are still started.
+ * The memory situation and load can currently only be determined on Linux hosts.
+ */
+void BuildOptions::setAdaptiveJobScheduling(bool enabled)
+{
+    d->adaptiveJobScheduling = enabled;
+}
+
 /*!
  * \brief Returns true iff qbs will not actually execute any commands, but just show what
  *        would happen.
@@ -399,11 +467,14 @@ void BuildOptions::setExecuteRulesOnly(bool onlyRules)
 bool operator==(const BuildOptions &bo1, const BuildOptions &bo2)
 {
     return bo1.changedFiles() == bo2.changedFiles()
+            && bo1.changedFilesComplete() == bo2.changedFilesComplete()
             && bo1.dryRun() == bo2.dryRun()
             && bo1.keepGoing() == bo2.keepGoing()
             && bo1.logElapsedTime() == bo2.logElapsedTime()
             && bo1.echoMode() == bo2.echoMode()
             && bo1.maxJobCount() == bo2.maxJobCount()
+            && bo1.provideMakeJobServer() == bo2.provideMakeJobServer()
+            && bo1.adaptiveJobScheduling() == bo2.adaptiveJobScheduling()
             && bo1.install() == bo2.install()
             && bo1.removeExistingInstallation() == bo2.removeExistingInstallation();
 }
@@ -443,10 +514,13 @@ qbs::BuildOptions qbs::BuildOptions::fromJson(const QJsonObject &data)
     using namespace Internal;
     BuildOptions opt;
     setValueFromJson(opt.d->changedFiles, data, "changed-files");
+    setValueFromJson(opt.d->changedFilesComplete, data, "changed-files-complete");
     setValueFromJson(opt.d->filesToConsider, data, "files-to-consider");
     setValueFromJson(opt.d->activeFileTags, data, "active-file-tags");
     setValueFromJson(opt.d->jobLimits, data, "job-limits");
     setValueFromJson(opt.d->maxJobCount, data, "max-job-count");
+    setValueFromJson(opt.d->provideMakeJobServer, data, "make-jobserver");
+    setValueFromJson(opt.d->adaptiveJobScheduling, data, "adaptive-job-scheduling");
     setValueFromJson(opt.d->dryRun, data, "dry-run");
     setValueFromJson(opt.d->keepGoing, data, "keep-going");
     setValueFromJson(opt.d->forceTimestampCheck, data, "check-timestamps");
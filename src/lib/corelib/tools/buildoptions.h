@@ -70,6 +70,9 @@ public:
     QStringList changedFiles() const;
     void setChangedFiles(const QStringList &changedFiles);
 
+    bool changedFilesComplete() const;
+    void setChangedFilesComplete(bool complete);
+
     QStringList activeFileTags() const;
     void setActiveFileTags(const QStringList &fileTags);
 
@@ -86,6 +89,12 @@ public:
     bool projectJobLimitsTakePrecedence() const;
     void setProjectJobLimitsTakePrecedence(bool toggle);
 
+    bool provideMakeJobServer() const;
+    void setProvideMakeJobServer(bool provide);
+
+    bool adaptiveJobScheduling() const;
+    void setAdaptiveJobScheduling(bool enabled);
+
     bool dryRun() const;
     void setDryRun(bool dryRun);
 
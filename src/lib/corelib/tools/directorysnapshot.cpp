@@ -0,0 +1,151 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qbs.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "directorysnapshot.h"
+
+#include "fileinfo.h"
+#include "parallelutils.h"
+
+#include <QtCore/qdiriterator.h>
+#include <QtCore/qfileinfo.h>
+
+#include <iterator>
+#include <utility>
+
+namespace qbs {
+namespace Internal {
+
+void DirectorySnapshot::setPreviousSnapshot(const DirectorySnapshot &previous)
+{
+    m_previousDirectories = previous.m_previousDirectories;
+    for (auto it = previous.m_directories.cbegin(); it != previous.m_directories.cend(); ++it)
+        m_previousDirectories.insert(it.key(), it.value());
+    m_directories.clear();
+}
+
+DirectorySnapshot::Directory DirectorySnapshot::directory(const QString &dirPath)
+{
+    auto it = m_directories.constFind(dirPath);
+    if (it == m_directories.constEnd())
+        it = m_directories.insert(dirPath, readDirectory(dirPath));
+    return it.value();
+}
+
+void DirectorySnapshot::prefetch(const std::vector<QString> &dirPaths)
+{
+    std::vector<std::pair<QString, Directory>> missing;
+    for (const QString &dirPath : dirPaths) {
+        if (!m_directories.contains(dirPath))
+            missing.emplace_back(dirPath, Directory());
+    }
+    parallelForEach(missing, [this](std::pair<QString, Directory> &dir) {
+        dir.second = readDirectory(dir.first);
+    }, QThread::idealThreadCount(), 8);
+    for (auto &dir : missing)
+        m_directories.insert(dir.first, std::move(dir.second));
+}
+
+std::vector<QString> DirectorySnapshot::subTree(const QString &dirPath,
+                                                const QString &excludedPrefix,
+                                                bool includeHidden)
+{
+    std::vector<QString> dirPaths;
+    std::vector<QString> currentLevel{dirPath};
+    while (!currentLevel.empty()) {
+        prefetch(currentLevel);
+        std::vector<QString> nextLevel;
+        for (const QString &currentDirPath : currentLevel) {
+            const auto entries = m_directories.value(currentDirPath).entries;
+            for (const Entry &entry : entries) {
+                if (!(entry.flags & IsDirectory) || (entry.flags & IsSymLink))
+                    continue;
+                if ((entry.flags & IsHidden) && !includeHidden)
+                    continue;
+                QString subDirPath = filePath(currentDirPath, entry.name);
+                if (!subDirPath.startsWith(excludedPrefix))
+                    nextLevel.push_back(std::move(subDirPath));
+            }
+        }
+        std::move(currentLevel.begin(), currentLevel.end(), std::back_inserter(dirPaths));
+        currentLevel = std::move(nextLevel);
+    }
+    return dirPaths;
+}
+
+QString DirectorySnapshot::filePath(const QString &dirPath, const QString &entryName)
+{
+    if (dirPath.endsWith(QLatin1Char('/')))
+        return dirPath + entryName;
+    return dirPath + QLatin1Char('/') + entryName;
+}
+
+// Called concurrently by prefetch(), so it must not modify the snapshot.
+DirectorySnapshot::Directory DirectorySnapshot::readDirectory(const QString &dirPath) const
+{
+    Directory dir;
+    const FileInfo fi(dirPath);
+    if (!fi.exists())
+        return dir;
+    dir.lastModified = fi.lastModified();
+    const auto previous = m_previousDirectories.constFind(dirPath);
+    if (previous != m_previousDirectories.constEnd()
+            && previous.value().lastModified == dir.lastModified) {
+        dir.entries = previous.value().entries;
+        return dir;
+    }
+    QDirIterator it(dirPath, QDir::AllEntries | QDir::Hidden | QDir::System
+                    | QDir::NoDotAndDotDot);
+    while (it.hasNext()) {
+        it.next();
+        const QFileInfo entryInfo = it.fileInfo();
+        Entry entry;
+        entry.name = entryInfo.fileName();
+        if (entryInfo.isDir())
+            entry.flags |= IsDirectory;
+        if (entryInfo.isSymLink())
+            entry.flags |= IsSymLink;
+        if (entryInfo.isHidden())
+            entry.flags |= IsHidden;
+        dir.entries.push_back(entry);
+    }
+    return dir;
+}
+
+} // namespace Internal
+} // namespace qbs
@@ -0,0 +1,117 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qbs.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QBS_DIRECTORYSNAPSHOT_H
+#define QBS_DIRECTORYSNAPSHOT_H
+
+#include "filetime.h"
+#include "persistence.h"
+
+#include <QtCore/qhash.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qstring.h>
+
+#include <vector>
+
+namespace qbs {
+namespace Internal {
+
+// Caches directory listings for wildcard expansion, so that all groups of a project
+// that match against the same directory tree need to read it only once.
+// The listings of a previous snapshot are reused for directories whose timestamp
+// has not changed. Not thread-safe; the parallelism happens internally.
+class QBS_AUTOTEST_EXPORT DirectorySnapshot
+{
+public:
+    enum EntryFlag { IsDirectory = 0x1, IsSymLink = 0x2, IsHidden = 0x4 };
+
+    struct Entry
+    {
+        QString name;
+        int flags = 0;
+
+        template<PersistentPool::OpType opType> void completeSerializationOp(PersistentPool &pool)
+        {
+            pool.serializationOp<opType>(name, flags);
+        }
+    };
+
+    struct Directory
+    {
+        FileTime lastModified; // Invalid if the directory does not exist.
+        QList<Entry> entries;
+
+        template<PersistentPool::OpType opType> void completeSerializationOp(PersistentPool &pool)
+        {
+            pool.serializationOp<opType>(lastModified, entries);
+        }
+    };
+
+    void setPreviousSnapshot(const DirectorySnapshot &previous);
+    void clearPreviousSnapshot() { m_previousDirectories.clear(); }
+
+    Directory directory(const QString &dirPath);
+
+    // Reads all directories that are not yet known, in parallel.
+    void prefetch(const std::vector<QString> &dirPaths);
+
+    // Returns dirPath and all its sub-directories, skipping symbolic links, directories
+    // starting with excludedPrefix and, unless includeHidden is true, hidden directories.
+    // The tree is read level by level, with the directories of each level read in parallel.
+    std::vector<QString> subTree(const QString &dirPath, const QString &excludedPrefix,
+                                 bool includeHidden);
+
+    static QString filePath(const QString &dirPath, const QString &entryName);
+
+    template<PersistentPool::OpType opType> void completeSerializationOp(PersistentPool &pool)
+    {
+        pool.serializationOp<opType>(m_directories);
+    }
+
+private:
+    Directory readDirectory(const QString &dirPath) const;
+
+    QHash<QString, Directory> m_directories;
+    QHash<QString, Directory> m_previousDirectories;
+};
+
+} // namespace Internal
+} // namespace qbs
+
+#endif // QBS_DIRECTORYSNAPSHOT_H
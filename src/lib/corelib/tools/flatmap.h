@@ -0,0 +1,218 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qbs.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QBS_FLATMAP_H
+#define QBS_FLATMAP_H
+
+#include <QtCore/qlist.h>
+#include <QtCore/qvector.h>
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace qbs {
+namespace Internal {
+
+// An associative container with the subset of the QMap API that is needed for item properties.
+// The entries live in one implicitly shared, contiguous vector sorted by key, so there is
+// one allocation per map rather than one per node, lookups are binary searches over adjacent
+// memory and copying a map (e.g. from a prototype) is as cheap as copying a QMap.
+// Iteration order is the same as for QMap.
+// Like with QVector, inserting into or removing from a map invalidates all its iterators.
+template<typename Key, typename T> class FlatMap
+{
+    using Entry = std::pair<Key, T>;
+    using Data = QVector<Entry>;
+
+    template<typename DataIterator, typename Ref, typename Ptr> class IteratorBase
+    {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = T;
+        using pointer = Ptr;
+        using reference = Ref;
+
+        IteratorBase() = default;
+        explicit IteratorBase(DataIterator it) : m_it(it) {}
+
+        const Key &key() const { return m_it->first; }
+        Ref value() const { return m_it->second; }
+        Ref operator*() const { return m_it->second; }
+        Ptr operator->() const { return &m_it->second; }
+
+        IteratorBase &operator++() { ++m_it; return *this; }
+        IteratorBase operator++(int) { IteratorBase tmp = *this; ++m_it; return tmp; }
+        IteratorBase &operator--() { --m_it; return *this; }
+        IteratorBase operator--(int) { IteratorBase tmp = *this; --m_it; return tmp; }
+
+        friend bool operator==(const IteratorBase &a, const IteratorBase &b)
+        {
+            return a.m_it == b.m_it;
+        }
+        friend bool operator!=(const IteratorBase &a, const IteratorBase &b) { return !(a == b); }
+
+        DataIterator dataIterator() const { return m_it; }
+
+    private:
+        DataIterator m_it = DataIterator();
+    };
+
+public:
+    using const_iterator = IteratorBase<typename Data::const_iterator, const T &, const T *>;
+    class iterator : public IteratorBase<typename Data::iterator, T &, T *>
+    {
+    public:
+        using IteratorBase<typename Data::iterator, T &, T *>::IteratorBase;
+        operator const_iterator() const { return const_iterator(this->dataIterator()); }
+    };
+    using ConstIterator = const_iterator;
+    using Iterator = iterator;
+    using key_type = Key;
+    using mapped_type = T;
+    using size_type = int;
+
+    iterator begin() { return iterator(m_data.begin()); }
+    iterator end() { return iterator(m_data.end()); }
+    const_iterator begin() const { return const_iterator(m_data.cbegin()); }
+    const_iterator end() const { return const_iterator(m_data.cend()); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+    const_iterator constBegin() const { return begin(); }
+    const_iterator constEnd() const { return end(); }
+
+    iterator find(const Key &key)
+    {
+        const auto it = lowerBound(key);
+        if (it == m_data.cend() || key < it->first)
+            return end();
+
+        // The position must be determined before begin() possibly detaches the data.
+        const int pos = it - m_data.cbegin();
+        return iterator(m_data.begin() + pos);
+    }
+    const_iterator find(const Key &key) const
+    {
+        const auto it = lowerBound(key);
+        return const_iterator(it == m_data.cend() || key < it->first ? m_data.cend() : it);
+    }
+    const_iterator constFind(const Key &key) const { return find(key); }
+    bool contains(const Key &key) const { return find(key) != end(); }
+
+    T value(const Key &key, const T &defaultValue = T()) const
+    {
+        const const_iterator it = find(key);
+        return it == end() ? defaultValue : it.value();
+    }
+
+    iterator insert(const Key &key, const T &value)
+    {
+        const int pos = lowerBound(key) - m_data.cbegin();
+        if (pos == m_data.size() || key < m_data.at(pos).first)
+            m_data.insert(pos, Entry(key, value));
+        else
+            m_data[pos].second = value;
+        return iterator(m_data.begin() + pos);
+    }
+
+    T &operator[](const Key &key)
+    {
+        const int pos = lowerBound(key) - m_data.cbegin();
+        if (pos == m_data.size() || key < m_data.at(pos).first)
+            m_data.insert(pos, Entry(key, T()));
+        return m_data[pos].second;
+    }
+
+    int remove(const Key &key)
+    {
+        const auto it = lowerBound(key);
+        if (it == m_data.cend() || key < it->first)
+            return 0;
+        m_data.remove(it - m_data.cbegin());
+        return 1;
+    }
+    iterator erase(const_iterator it)
+    {
+        const int pos = it.dataIterator() - m_data.cbegin();
+        m_data.remove(pos);
+        return iterator(m_data.begin() + pos);
+    }
+
+    QList<Key> keys() const
+    {
+        QList<Key> result;
+        result.reserve(m_data.size());
+        for (const Entry &e : m_data)
+            result << e.first;
+        return result;
+    }
+    QList<T> values() const
+    {
+        QList<T> result;
+        result.reserve(m_data.size());
+        for (const Entry &e : m_data)
+            result << e.second;
+        return result;
+    }
+
+    int size() const { return m_data.size(); }
+    int count() const { return m_data.size(); }
+    bool isEmpty() const { return m_data.isEmpty(); }
+    bool empty() const { return m_data.isEmpty(); }
+    void clear() { m_data.clear(); }
+    void reserve(int size) { m_data.reserve(size); }
+
+    bool operator==(const FlatMap &other) const { return m_data == other.m_data; }
+    bool operator!=(const FlatMap &other) const { return !(*this == other); }
+
+private:
+    typename Data::const_iterator lowerBound(const Key &key) const
+    {
+        return std::lower_bound(m_data.cbegin(), m_data.cend(), key,
+                                [](const Entry &e, const Key &k) { return e.first < k; });
+    }
+
+    Data m_data;
+};
+
+} // namespace Internal
+} // namespace qbs
+
+#endif // QBS_FLATMAP_H
@@ -0,0 +1,249 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qbs.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "jobserver.h"
+
+#include <logging/categories.h>
+#include <tools/qbsassert.h>
+
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qprocess.h>
+#include <QtCore/quuid.h>
+
+#include <algorithm>
+
+#ifdef Q_OS_UNIX
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace qbs {
+namespace Internal {
+
+JobServer &JobServer::instance()
+{
+    static JobServer server;
+    return server;
+}
+
+JobServer::JobServer()
+{
+    setupFromEnvironment();
+}
+
+JobServer::~JobServer()
+{
+    removeFifo();
+}
+
+void JobServer::registerClient(int maxJobCount, bool provideMakeJobServer)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_clientJobCounts.push_back(maxJobCount);
+    if (!provideMakeJobServer)
+        return;
+    ++m_makeJobServerClientCount;
+    if (m_fifoFd == -1)
+        createFifo(maxJobCount);
+}
+
+void JobServer::unregisterClient(int maxJobCount, bool provideMakeJobServer)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto it = std::find(m_clientJobCounts.begin(), m_clientJobCounts.end(), maxJobCount);
+    QBS_ASSERT(it != m_clientJobCounts.end(), return);
+    m_clientJobCounts.erase(it);
+    if (provideMakeJobServer)
+        --m_makeJobServerClientCount;
+    if (m_clientJobCounts.empty() && m_ownsFifo) {
+        QBS_ASSERT(m_tokensInUse == 0, return);
+        removeFifo();
+    }
+}
+
+bool JobServer::tryAcquireToken()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_fifoFd == -1) {
+        const int maxTokenCount = m_clientJobCounts.empty()
+                ? 1 : *std::max_element(m_clientJobCounts.cbegin(), m_clientJobCounts.cend());
+        if (m_tokensInUse >= maxTokenCount)
+            return false;
+        ++m_tokensInUse;
+        return true;
+    }
+    if (m_tokensInUse == 0) { // The implicit token of our process.
+        ++m_tokensInUse;
+        return true;
+    }
+#ifdef Q_OS_UNIX
+    char token;
+    if (::read(m_fifoFd, &token, 1) != 1)
+        return false;
+    m_tokensFromFifo.push_back(token);
+    ++m_tokensInUse;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void JobServer::releaseToken()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        QBS_ASSERT(m_tokensInUse > 0, return);
+        --m_tokensInUse;
+#ifdef Q_OS_UNIX
+        if (m_tokensOutsideFifo > 0) {
+            // Handed out before the fifo existed; from now on, it is shared via the fifo.
+            --m_tokensOutsideFifo;
+            const char token = '+';
+            if (::write(m_fifoFd, &token, 1) != 1)
+                qCWarning(lcExec) << "failed to return token to job server:" << errno;
+        } else if (!m_tokensFromFifo.empty()) {
+            const char token = m_tokensFromFifo.back();
+            m_tokensFromFifo.pop_back();
+            if (::write(m_fifoFd, &token, 1) != 1)
+                qCWarning(lcExec) << "failed to return token to job server:" << errno;
+        }
+#endif
+    }
+    emit tokenReleased();
+}
+
+bool JobServer::hasExternalTokens() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_fifoFd != -1;
+}
+
+QString JobServer::makeFlags() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_makeJobServerClientCount > 0 ? m_makeFlags : QString();
+}
+
+// Only the named pipe variant of the protocol, which GNU make uses by default since
+// version 4.4, is supported. With the anonymous pipe variant, we would have to switch
+// a file descriptor that we share with make and all its other children to non-blocking mode.
+void JobServer::setupFromEnvironment()
+{
+#ifdef Q_OS_UNIX
+    const QString makeFlags = QProcessEnvironment::systemEnvironment()
+            .value(QStringLiteral("MAKEFLAGS"));
+    const QString authOption = QStringLiteral("--jobserver-auth=fifo:");
+    const int authIndex = makeFlags.lastIndexOf(authOption);
+    if (authIndex == -1)
+        return;
+    const int pathIndex = authIndex + authOption.length();
+    int pathEnd = makeFlags.indexOf(QLatin1Char(' '), pathIndex);
+    if (pathEnd == -1)
+        pathEnd = makeFlags.length();
+    const QString fifoPath = makeFlags.mid(pathIndex, pathEnd - pathIndex);
+    m_fifoFd = ::open(QFile::encodeName(fifoPath).constData(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (m_fifoFd == -1) {
+        qCWarning(lcExec) << "cannot open job server fifo" << fifoPath << ":" << errno;
+        return;
+    }
+    qCDebug(lcExec) << "using job server at" << fifoPath;
+    m_fifoPath = fifoPath;
+    m_makeFlags = makeFlags;
+#endif
+}
+
+void JobServer::createFifo(int totalTokenCount)
+{
+#ifdef Q_OS_UNIX
+    // We hold the implicit token ourselves, and other builds in this process may already
+    // be using some more. These are put into the fifo once they are released.
+    const int tokensOutsideFifo = std::max(m_tokensInUse - 1, 0);
+    const int tokenCount = std::max(totalTokenCount - 1 - tokensOutsideFifo, 0);
+    const QString fifoPath = QDir::tempPath() + QStringLiteral("/qbs-jobserver-%1-%2")
+            .arg(QCoreApplication::applicationPid())
+            .arg(QUuid::createUuid().toString(QUuid::Id128));
+    const QByteArray encodedPath = QFile::encodeName(fifoPath);
+    if (::mkfifo(encodedPath.constData(), 0600) != 0) {
+        qCWarning(lcExec) << "cannot create job server fifo" << fifoPath << ":" << errno;
+        return;
+    }
+    m_fifoFd = ::open(encodedPath.constData(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (m_fifoFd == -1) {
+        qCWarning(lcExec) << "cannot open job server fifo" << fifoPath << ":" << errno;
+        ::unlink(encodedPath.constData());
+        return;
+    }
+    const QByteArray tokens(tokenCount, '+');
+    if (!tokens.isEmpty() && ::write(m_fifoFd, tokens.constData(), size_t(tokens.size()))
+            != tokens.size()) {
+        qCWarning(lcExec) << "cannot fill job server fifo" << fifoPath << ":" << errno;
+    }
+    qCDebug(lcExec) << "providing job server with" << totalTokenCount << "tokens at" << fifoPath
+                    << "," << tokensOutsideFifo << "of which are still in use";
+    m_fifoPath = fifoPath;
+    m_ownsFifo = true;
+    m_tokensOutsideFifo = tokensOutsideFifo;
+    m_makeFlags = QStringLiteral("-j%1 --jobserver-auth=fifo:%2").arg(totalTokenCount)
+            .arg(fifoPath);
+#else
+    Q_UNUSED(totalTokenCount);
+#endif
+}
+
+void JobServer::removeFifo()
+{
+#ifdef Q_OS_UNIX
+    if (!m_ownsFifo)
+        return;
+    ::close(m_fifoFd);
+    ::unlink(QFile::encodeName(m_fifoPath).constData());
+    m_fifoFd = -1;
+    m_fifoPath.clear();
+    m_ownsFifo = false;
+    m_tokensOutsideFifo = 0;
+    m_makeFlags.clear();
+#endif
+}
+
+} // namespace Internal
+} // namespace qbs
@@ -0,0 +1,102 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qbs.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QBS_JOBSERVER_H
+#define QBS_JOBSERVER_H
+
+#include <QtCore/qobject.h>
+#include <QtCore/qstring.h>
+
+#include <mutex>
+#include <vector>
+
+namespace qbs {
+namespace Internal {
+
+// Hands out the tokens that executors need for running a command. All builds in the process
+// share the same tokens, so building several configurations at once does not multiply the
+// number of concurrent jobs.
+// If qbs is run by a GNU make that provides a job server via a named pipe, the tokens are
+// taken from there. On request, qbs also provides such a job server to the processes it runs.
+class JobServer : public QObject
+{
+    Q_OBJECT
+public:
+    static JobServer &instance();
+
+    void registerClient(int maxJobCount, bool provideMakeJobServer);
+    void unregisterClient(int maxJobCount, bool provideMakeJobServer);
+
+    bool tryAcquireToken();
+    void releaseToken();
+
+    // If this is true, tokens can also become available without the tokenReleased() signal
+    // being emitted, because they are shared with other processes.
+    bool hasExternalTokens() const;
+
+    // The value of MAKEFLAGS for processes run by commands, or an empty string.
+    QString makeFlags() const;
+
+signals:
+    void tokenReleased();
+
+private:
+    JobServer();
+    ~JobServer() override;
+
+    void setupFromEnvironment();
+    void createFifo(int totalTokenCount);
+    void removeFifo();
+
+    mutable std::mutex m_mutex;
+    std::vector<int> m_clientJobCounts;
+    int m_makeJobServerClientCount = 0;
+    int m_tokensInUse = 0;
+    int m_fifoFd = -1;
+    QString m_fifoPath;
+    bool m_ownsFifo = false;
+    std::vector<char> m_tokensFromFifo;
+    int m_tokensOutsideFifo = 0;
+    QString m_makeFlags;
+};
+
+} // namespace Internal
+} // namespace qbs
+
+#endif // QBS_JOBSERVER_H
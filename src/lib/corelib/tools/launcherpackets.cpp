@@ -72,12 +72,12 @@ StartProcessPacket::StartProcessPacket(quintptr token)
 
 void StartProcessPacket::doSerialize(QDataStream &stream) const
 {
-    stream << command << arguments << workingDir << env;
+    stream << command << arguments << workingDir << env << trackMemoryUsage;
 }
 
 void StartProcessPacket::doDeserialize(QDataStream &stream)
 {
-    stream >> command >> arguments >> workingDir >> env;
+    stream >> command >> arguments >> workingDir >> env >> trackMemoryUsage;
 }
 
 
@@ -125,7 +125,7 @@ void ProcessFinishedPacket::doSerialize(QDataStream &stream) const
 {
     stream << errorString << stdOut << stdErr
            << static_cast<quint8>(exitStatus) << static_cast<quint8>(error)
-           << exitCode;
+           << exitCode << peakMemoryUsage;
 }
 
 void ProcessFinishedPacket::doDeserialize(QDataStream &stream)
@@ -136,7 +136,7 @@ void ProcessFinishedPacket::doDeserialize(QDataStream &stream)
     exitStatus = static_cast<QProcess::ExitStatus>(val);
     stream >> val;
     error = static_cast<QProcess::ProcessError>(val);
-    stream >> exitCode;
+    stream >> exitCode >> peakMemoryUsage;
 }
 
 ShutdownPacket::ShutdownPacket() : LauncherPacket(LauncherPacketType::Shutdown, 0) { }
@@ -114,6 +114,7 @@ public:
     QStringList arguments;
     QString workingDir;
     QStringList env;
+    bool trackMemoryUsage = false;
 
 private:
     void doSerialize(QDataStream &stream) const override;
@@ -164,6 +165,7 @@ public:
     QProcess::ExitStatus exitStatus = QProcess::ExitStatus::NormalExit;
     QProcess::ProcessError error = QProcess::ProcessError::UnknownError;
     int exitCode = 0;
+    qint64 peakMemoryUsage = -1;
 
 private:
     void doSerialize(QDataStream &stream) const override;
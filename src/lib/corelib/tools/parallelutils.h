@@ -0,0 +1,93 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qbs.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QBS_PARALLELUTILS_H
+#define QBS_PARALLELUTILS_H
+
+#include <QtCore/qthread.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace qbs {
+namespace Internal {
+
+// Calls f for all elements of the random-access container c, distributing the work among
+// up to maxThreadCount threads, one of which is the calling thread.
+// Intended for I/O-bound operations such as retrieving file timestamps, where the latency
+// of the individual calls dominates. f must not throw and must be safe to call concurrently
+// for different elements.
+// The elements are handed out to the threads in groups of batchSize; callers whose elements
+// represent larger chunks of work should pass a smaller value.
+template<typename C, typename F>
+void parallelForEach(C &c, const F &f, int maxThreadCount = QThread::idealThreadCount(),
+                     size_t batchSize = 32)
+{
+    const size_t count = c.size();
+    const size_t threadCount = std::min<size_t>(std::max(maxThreadCount, 1),
+                                                (count + batchSize - 1) / batchSize);
+    if (threadCount <= 1) {
+        for (auto &element : c)
+            f(element);
+        return;
+    }
+    std::atomic<size_t> nextBatch{0};
+    const auto worker = [&] {
+        for (size_t start = nextBatch.fetch_add(batchSize); start < count;
+             start = nextBatch.fetch_add(batchSize)) {
+            const size_t end = std::min(start + batchSize, count);
+            for (size_t i = start; i < end; ++i)
+                f(c[i]);
+        }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    for (size_t i = 1; i < threadCount; ++i)
+        threads.emplace_back(worker);
+    worker();
+    for (std::thread &t : threads)
+        t.join();
+}
+
+} // namespace Internal
+} // namespace qbs
+
+#endif // QBS_PARALLELUTILS_H
@@ -70,6 +70,7 @@ void QbsProcess::start(const QString &command, const QStringList &arguments)
     }
     m_command = command;
     m_arguments = arguments;
+    m_peakMemoryUsage = -1;
     m_state = QProcess::Starting;
     if (LauncherInterface::socket()->isReady())
         doStart();
@@ -83,6 +84,7 @@ void QbsProcess::doStart()
     p.arguments = m_arguments;
     p.env = m_environment.toStringList();
     p.workingDir = m_workingDirectory;
+    p.trackMemoryUsage = m_trackMemoryUsage;
     sendPacket(p);
 }
 
@@ -178,6 +180,7 @@ void QbsProcess::handleFinishedPacket(const QByteArray &packetData)
     m_stdout = packet.stdOut;
     m_stderr = packet.stdErr;
     m_errorString = packet.errorString;
+    m_peakMemoryUsage = packet.peakMemoryUsage;
     emit finished(m_exitCode);
 }
 
@@ -68,6 +68,11 @@ public:
     QProcess::ProcessError error() const { return m_error; }
     QString errorString() const { return m_errorString; }
 
+    // The highest memory usage of the process and its children in bytes, or -1 if unknown.
+    // Only measured if tracking was enabled at start time.
+    void setTrackMemoryUsage(bool track) { m_trackMemoryUsage = track; }
+    qint64 peakMemoryUsage() const { return m_peakMemoryUsage; }
+
 signals:
     void error(QProcess::ProcessError error);
     void finished(int exitCode);
@@ -96,8 +101,10 @@ private:
     QProcess::ProcessError m_error = QProcess::UnknownError;
     QProcess::ProcessState m_state = QProcess::NotRunning;
     int m_exitCode = 0;
+    qint64 m_peakMemoryUsage = -1;
     int m_connectionAttempts = 0;
     bool m_socketError = false;
+    bool m_trackMemoryUsage = false;
 };
 
 } // namespace Internal
@@ -0,0 +1,115 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qbs.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "systemresources.h"
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qlist.h>
+
+namespace qbs {
+namespace Internal {
+
+#ifdef Q_OS_LINUX
+static QByteArray readProcFile(const char *filePath)
+{
+    QFile f(QString::fromLatin1(filePath));
+    return f.open(QIODevice::ReadOnly) ? f.readAll() : QByteArray();
+}
+
+// Lines look like this: "MemAvailable:   12345678 kB"
+static qint64 memInfoValue(const QByteArray &memInfo, const QByteArray &key)
+{
+    const int keyIndex = memInfo.indexOf(key + ':');
+    if (keyIndex == -1)
+        return -1;
+    const int valueIndex = keyIndex + key.size() + 1;
+    const int lineEnd = memInfo.indexOf('\n', valueIndex);
+    const QByteArray value = memInfo.mid(valueIndex, lineEnd - valueIndex).simplified();
+    bool ok;
+    const qint64 kiloBytes = value.left(value.indexOf(' ')).toLongLong(&ok);
+    return ok ? kiloBytes * 1024 : -1;
+}
+
+// Lines look like this: "some avg10=0.00 avg60=0.00 avg300=0.00 total=0"
+static double pressureValue(const QByteArray &pressure, const QByteArray &kind)
+{
+    const QList<QByteArray> lines = pressure.split('\n');
+    for (const QByteArray &line : lines) {
+        if (!line.startsWith(kind + ' '))
+            continue;
+        const QList<QByteArray> fields = line.split(' ');
+        for (const QByteArray &field : fields) {
+            if (field.startsWith("avg10=")) {
+                bool ok;
+                const double value = field.mid(6).toDouble(&ok);
+                return ok ? value : -1;
+            }
+        }
+    }
+    return -1;
+}
+#endif // Q_OS_LINUX
+
+SystemResources SystemResources::query()
+{
+    SystemResources resources;
+#ifdef Q_OS_LINUX
+    const QByteArray memInfo = readProcFile("/proc/meminfo");
+    resources.totalMemory = memInfoValue(memInfo, "MemTotal");
+    resources.availableMemory = memInfoValue(memInfo, "MemAvailable");
+    const QByteArray memoryPressure = readProcFile("/proc/pressure/memory");
+    resources.memoryPressure = pressureValue(memoryPressure, "some");
+    resources.memoryFullPressure = pressureValue(memoryPressure, "full");
+    const QByteArray loadAverage = readProcFile("/proc/loadavg");
+    bool ok;
+    const double load = loadAverage.left(loadAverage.indexOf(' ')).toDouble(&ok);
+    if (ok)
+        resources.loadAverage = load;
+#endif
+
+    // Autotests cannot control how much memory the host has available.
+    const QByteArray availableMemory = qgetenv("QBS_AUTOTEST_AVAILABLE_MEMORY");
+    if (!availableMemory.isEmpty())
+        resources.availableMemory = availableMemory.toLongLong();
+    return resources;
+}
+
+} // namespace Internal
+} // namespace qbs
@@ -13,16 +13,19 @@ HEADERS += \
     $$PWD/clangclinfo.h \
     $$PWD/codelocation.h \
     $$PWD/commandechomode.h \
+    $$PWD/directorysnapshot.h \
     $$PWD/dynamictypecheck.h \
     $$PWD/error.h \
     $$PWD/executablefinder.h \
     $$PWD/fileinfo.h \
     $$PWD/filesaver.h \
     $$PWD/filetime.h \
+    $$PWD/flatmap.h \
     $$PWD/generateoptions.h \
     $$PWD/id.h \
     $$PWD/iosutils.h \
     $$PWD/joblimits.h \
+    $$PWD/jobserver.h \
     $$PWD/jsliterals.h \
     $$PWD/jsonhelper.h \
     $$PWD/launcherinterface.h \
@@ -36,6 +39,7 @@ HEADERS += \
     $$PWD/settings.h \
     $$PWD/settingsmodel.h \
     $$PWD/settingsrepresentation.h \
+    $$PWD/parallelutils.h \
     $$PWD/pathutils.h \
     $$PWD/preferences.h \
     $$PWD/profile.h \
@@ -50,6 +54,7 @@ HEADERS += \
     $$PWD/shellutils.h \
     $$PWD/stlutils.h \
     $$PWD/stringutils.h \
+    $$PWD/systemresources.h \
     $$PWD/toolchains.h \
     $$PWD/hostosinfo.h \
     $$PWD/buildoptions.h \
@@ -72,6 +77,7 @@ SOURCES += \
     $$PWD/clangclinfo.cpp \
     $$PWD/codelocation.cpp \
     $$PWD/commandechomode.cpp \
+    $$PWD/directorysnapshot.cpp \
     $$PWD/error.cpp \
     $$PWD/executablefinder.cpp \
     $$PWD/fileinfo.cpp \
@@ -80,6 +86,7 @@ SOURCES += \
     $$PWD/generateoptions.cpp \
     $$PWD/id.cpp \
     $$PWD/joblimits.cpp \
+    $$PWD/jobserver.cpp \
     $$PWD/jsliterals.cpp \
     $$PWD/launcherinterface.cpp \
     $$PWD/launcherpackets.cpp \
@@ -101,6 +108,7 @@ SOURCES += \
     $$PWD/qbspluginmanager.cpp \
     $$PWD/qbsprocess.cpp \
     $$PWD/shellutils.cpp \
+    $$PWD/systemresources.cpp \
     $$PWD/buildoptions.cpp \
     $$PWD/installoptions.cpp \
     $$PWD/cleanoptions.cpp \
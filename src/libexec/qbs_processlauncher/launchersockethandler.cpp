@@ -42,23 +42,78 @@
 #include "launcherlogging.h"
 
 #include <QtCore/qcoreapplication.h>
+#include <QtCore/qfile.h>
 #include <QtCore/qprocess.h>
 #include <QtCore/qtimer.h>
 #include <QtNetwork/qlocalsocket.h>
 
+#include <algorithm>
+
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#endif
+
 namespace qbs {
 namespace Internal {
 
+// Resident memory of the process and all its descendants, in bytes.
+static qint64 processTreeMemoryUsage(qint64 pid)
+{
+#ifdef Q_OS_LINUX
+    static const qint64 pageSize = ::sysconf(_SC_PAGESIZE);
+    qint64 usage = 0;
+    QFile statm(QStringLiteral("/proc/%1/statm").arg(pid));
+    if (statm.open(QIODevice::ReadOnly)) {
+        const QList<QByteArray> fields = statm.readAll().split(' ');
+        if (fields.size() > 1)
+            usage += fields.at(1).toLongLong() * pageSize;
+    }
+    QFile children(QStringLiteral("/proc/%1/task/%1/children").arg(pid));
+    if (children.open(QIODevice::ReadOnly)) {
+        const QList<QByteArray> childPids = children.readAll().simplified().split(' ');
+        for (const QByteArray &childPid : childPids) {
+            if (!childPid.isEmpty())
+                usage += processTreeMemoryUsage(childPid.toLongLong());
+        }
+    }
+    return usage;
+#else
+    Q_UNUSED(pid);
+    return -1;
+#endif
+}
+
 class Process : public QProcess
 {
     Q_OBJECT
 public:
     Process(quintptr token, QObject *parent = nullptr) :
-        QProcess(parent), m_token(token), m_stopTimer(new QTimer(this))
+        QProcess(parent), m_token(token), m_stopTimer(new QTimer(this)),
+        m_memoryUsageTimer(new QTimer(this))
     {
         m_stopTimer->setSingleShot(true);
         connect(m_stopTimer, &QTimer::timeout, this, &Process::cancel);
+        // Sampling is cheap, but not free. The price is that processes living for less than
+        // the interval, such as short-lived children of a compiler driver, can go unnoticed,
+        // so the recorded peak is a lower bound.
+        m_memoryUsageTimer->setInterval(200);
+        connect(m_memoryUsageTimer, &QTimer::timeout, this, &Process::sampleMemoryUsage);
+        connect(this, &QProcess::started, this, [this] {
+            if (m_trackMemoryUsage)
+                m_memoryUsageTimer->start();
+        });
+        connect(this, &QProcess::stateChanged, this, [this](QProcess::ProcessState state) {
+            if (state == QProcess::NotRunning)
+                m_memoryUsageTimer->stop();
+        });
+    }
+
+    void setTrackMemoryUsage(bool track)
+    {
+        m_trackMemoryUsage = track;
+        m_peakMemoryUsage = -1;
     }
+    qint64 peakMemoryUsage() const { return m_peakMemoryUsage; }
 
     void cancel()
     {
@@ -92,8 +147,17 @@ signals:
     void failedToStop();
 
 private:
+    void sampleMemoryUsage()
+    {
+        if (state() == QProcess::Running)
+            m_peakMemoryUsage = std::max(m_peakMemoryUsage, processTreeMemoryUsage(processId()));
+    }
+
     const quintptr m_token;
     QTimer * const m_stopTimer;
+    QTimer * const m_memoryUsageTimer;
+    qint64 m_peakMemoryUsage = -1;
+    bool m_trackMemoryUsage = false;
     enum class StopState { Inactive, Terminating, Killing } m_stopState = StopState::Inactive;
 };
 
@@ -201,6 +265,7 @@ void LauncherSocketHandler::handleProcessFinished()
     packet.errorString = proc->errorString();
     packet.exitCode = proc->exitCode();
     packet.exitStatus = proc->exitStatus();
+    packet.peakMemoryUsage = proc->peakMemoryUsage();
     packet.stdErr = proc->readAllStandardError();
     packet.stdOut = proc->readAllStandardOutput();
     sendPacket(packet);
@@ -236,6 +301,7 @@ void LauncherSocketHandler::handleStartPacket()
                 m_packetParser.packetData());
     process->setEnvironment(packet.env);
     process->setWorkingDirectory(packet.workingDir);
+    process->setTrackMemoryUsage(packet.trackMemoryUsage);
     process->start(packet.command, packet.arguments);
 }
 
@@ -1,6 +1,7 @@
 TEMPLATE = subdirs
 SUBDIRS += clangcompilationdb
 SUBDIRS += makefilegenerator
+SUBDIRS += ninjagenerator
 SUBDIRS += visualstudio
 SUBDIRS += iarew
 SUBDIRS += keiluv
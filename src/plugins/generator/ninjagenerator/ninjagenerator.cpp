@@ -0,0 +1,316 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qbs.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "ninjagenerator.h"
+
+#include <logging/logger.h>
+#include <logging/translator.h>
+#include <tools/error.h>
+#include <tools/hostosinfo.h>
+#include <tools/shellutils.h>
+#include <tools/stringconstants.h>
+#include <tools/set.h>
+
+#include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qprocess.h>
+#include <QtCore/qregularexpression.h>
+#include <QtCore/qtextstream.h>
+
+#include <algorithm>
+
+namespace qbs {
+using namespace Internal;
+
+QString NinjaGenerator::generatorName() const
+{
+    return QStringLiteral("ninja");
+}
+
+// Paths appear in "build" statements, where spaces and colons are significant.
+static QString escapedPath(const QString &path)
+{
+    QString escaped = path;
+    escaped.replace(QLatin1Char('$'), QLatin1String("$$"));
+    escaped.replace(QLatin1Char(' '), QLatin1String("$ "));
+    escaped.replace(QLatin1Char(':'), QLatin1String("$:"));
+    return escaped;
+}
+
+static QString escapedValue(const QString &value)
+{
+    QString escaped = value;
+    return escaped.replace(QLatin1Char('$'), QLatin1String("$$"));
+}
+
+static QString makeValidTargetName(const ProductData &product)
+{
+    static const QRegularExpression illegalChar(QStringLiteral("[^_.0-9A-Za-z]"));
+    QString name = product.name();
+    name.replace(illegalChar, QStringLiteral("_"));
+    if (!product.multiplexConfigurationId().isEmpty())
+        name.append(QLatin1Char('_')).append(product.multiplexConfigurationId());
+    return name;
+}
+
+// Only the variables that differ from the environment qbs itself runs in are exported,
+// as ninja is expected to be invoked from a similar environment.
+static QStringList environmentChanges(const QProcessEnvironment &environment)
+{
+    static const QProcessEnvironment systemEnvironment
+            = QProcessEnvironment::systemEnvironment();
+    QStringList changes;
+    const auto keys = environment.keys();
+    for (const QString &key : keys) {
+        const QString value = environment.value(key);
+        if (!systemEnvironment.contains(key) || systemEnvironment.value(key) != value)
+            changes << key + QLatin1Char('=') + value;
+    }
+    return changes;
+}
+
+static QString processCommandLine(const RuleCommand &command)
+{
+    QStringList parts;
+    if (!command.workingDirectory().isEmpty()) {
+        parts << (HostOsInfo::isWindowsHost()
+                  ? QStringLiteral("cd /d ") : QStringLiteral("cd "))
+                 + shellQuote(QDir::toNativeSeparators(command.workingDirectory()));
+    }
+    const QStringList envChanges = environmentChanges(command.environment());
+    if (HostOsInfo::isWindowsHost()) {
+        for (const QString &assignment : envChanges)
+            parts << QStringLiteral("set \"%1\"").arg(assignment);
+    }
+    QString commandLine = shellQuote(QDir::toNativeSeparators(command.executable()),
+                                     command.arguments());
+    if (!HostOsInfo::isWindowsHost() && !envChanges.empty())
+        commandLine.prepend(QStringLiteral("env ") + shellQuote(envChanges) + QLatin1Char(' '));
+    parts << commandLine;
+    return parts.join(QLatin1String(" && "));
+}
+
+// Compilations whose header dependencies can be reported by the compiler itself, so ninja
+// does not depend on scan results being present at generation time.
+static bool isCompileTransformer(const TransformerData &transformerData)
+{
+    static const QStringList sourceTags{QStringLiteral("c"), QStringLiteral("cpp"),
+                                        QStringLiteral("objc"), QStringLiteral("objcpp")};
+    const auto outputs = transformerData.outputs();
+    if (outputs.size() != 1 || !outputs.constFirst().fileTags().contains(QStringLiteral("obj")))
+        return false;
+    const auto inputs = transformerData.inputs();
+    return std::any_of(inputs.cbegin(), inputs.cend(), [](const ArtifactData &input) {
+        const auto fileTags = input.fileTags();
+        return std::any_of(fileTags.cbegin(), fileTags.cend(), [](const QString &tag) {
+            return sourceTags.contains(tag);
+        });
+    });
+}
+
+void NinjaGenerator::generate()
+{
+    const GeneratableProject genProject = project();
+    for (auto it = genProject.projects.cbegin(); it != genProject.projects.cend(); ++it) {
+        const QString &configurationName = it.key();
+        const Project &theProject = it.value();
+        const ProjectData projectData = theProject.projectData();
+        const QString ninjaFilePath = projectData.buildDirectory()
+                + QLatin1String("/build.ninja");
+        QFile ninjaFile(ninjaFilePath);
+        if (!ninjaFile.open(QIODevice::WriteOnly)) {
+            throw ErrorInfo(Tr::tr("Failed to create '%1': %2")
+                            .arg(ninjaFilePath, ninjaFile.errorString()));
+        }
+        ErrorInfo error;
+        const ProjectTransformerData projectTransformerData = theProject.transformerData(&error);
+        if (error.hasError())
+            throw error;
+
+        // Transformers with JavaScriptCommands are handed back to qbs, restricted to the
+        // transformer's inputs and output tags.
+        QStringList qbsCommandLine{QDir::toNativeSeparators(
+                        qbsExecutableFilePath().absoluteFilePath()), QStringLiteral("build")};
+        if (!qbsSettingsDir().isEmpty())
+            qbsCommandLine << QStringLiteral("--settings-dir") << qbsSettingsDir();
+        qbsCommandLine << QStringLiteral("-f") << genProject.filePath().absoluteFilePath()
+                       << QStringLiteral("-d") << genProject.baseBuildDirectory().absolutePath()
+                       << QStringLiteral("--wait-lock") << QStringLiteral("--no-install")
+                       << genProject.commandLines.value(configurationName);
+
+        QTextStream stream(&ninjaFile);
+        stream << "# This file was generated by qbs" << "\n\n";
+        stream << "ninja_required_version = 1.5\n\n";
+        stream << "rule qbs_process\n"
+               << "  command = " << (HostOsInfo::isWindowsHost() ? "cmd /c " : "")
+               << "$command\n"
+               << "  description = $description\n\n";
+        stream << "pool qbs_javascript\n"
+               << "  depth = 1\n\n";
+        stream << "rule qbs_javascript\n"
+               << "  command = $command\n"
+               << "  description = $description\n"
+               << "  pool = qbs_javascript\n"
+               << "  restat = 1\n\n";
+
+        QStringList allTargets;
+        QStringList allDefaultTargets;
+        int unscannedCompilations = 0;
+        for (const auto &d : projectTransformerData) {
+            const ProductData productData = d.first;
+            const QString productTarget = makeValidTargetName(productData);
+            const bool hasGccLikeToolchain = productData.moduleProperties()
+                    .getModulePropertiesAsStringList(StringConstants::qbsModule(),
+                                                     QStringLiteral("toolchain"))
+                    .contains(QStringLiteral("gcc"));
+            if (productData.properties().value(
+                        StringConstants::builtByDefaultProperty()).toBool()) {
+                allDefaultTargets.push_back(productTarget);
+            }
+            allTargets.push_back(productTarget);
+            const ProductTransformerData productTransformerData = d.second;
+            for (const TransformerData &transformerData : productTransformerData) {
+                QStringList outputs;
+                Set<QString> outputTags;
+                const auto outputArtifacts = transformerData.outputs();
+                for (const ArtifactData &output : outputArtifacts) {
+                    outputs << escapedPath(output.filePath());
+                    const auto fileTags = output.fileTags();
+                    for (const QString &tag : fileTags)
+                        outputTags << tag;
+                }
+                QStringList inputs;
+                QStringList inputFilePaths;
+                const auto inputArtifacts = transformerData.inputs();
+                for (const ArtifactData &input : inputArtifacts) {
+                    inputs << escapedPath(input.filePath());
+                    inputFilePaths << input.filePath();
+                }
+                QStringList implicitInputs;
+                const auto fileDependencies = transformerData.fileDependencies();
+                for (const QString &filePath : fileDependencies)
+                    implicitInputs << escapedPath(filePath);
+
+                const RuleCommandList commands = transformerData.commands();
+                if (commands.empty()) {
+                    stream << "build " << outputs.join(QLatin1Char(' ')) << ": phony "
+                           << inputs.join(QLatin1Char(' ')) << "\n\n";
+                    continue;
+                }
+                const bool hasJsCommands = std::any_of(commands.cbegin(), commands.cend(),
+                        [](const RuleCommand &command) {
+                    return command.type() == RuleCommand::JavaScriptCommandType;
+                });
+                QString depFilePath;
+                if (!hasJsCommands && isCompileTransformer(transformerData)) {
+                    if (hasGccLikeToolchain && commands.size() == 1) {
+                        depFilePath = outputArtifacts.constFirst().filePath()
+                                + QLatin1String(".d");
+                    } else if (implicitInputs.empty()) {
+                        ++unscannedCompilations;
+                    }
+                }
+                QString commandLine;
+                if (hasJsCommands) {
+                    QStringList args = qbsCommandLine;
+                    args << QStringLiteral("-p") << productData.name();
+                    if (!inputFilePaths.empty()) {
+                        args << QStringLiteral("--files-to-consider")
+                             << inputFilePaths.join(QLatin1Char(','));
+                    }
+                    args << QStringLiteral("--active-file-tags")
+                         << outputTags.toStringList().join(QLatin1Char(','));
+                    commandLine = shellQuote(args);
+                } else {
+                    QStringList commandLines;
+                    for (const RuleCommand &command : commands)
+                        commandLines << processCommandLine(command);
+                    commandLine = commandLines.join(QLatin1String(" && "));
+                    if (!depFilePath.isEmpty()) {
+                        commandLine += QLatin1Char(' ') + shellQuote(QStringList{
+                                QStringLiteral("-MD"), QStringLiteral("-MF"),
+                                QDir::toNativeSeparators(depFilePath)});
+                    }
+                }
+                QString description = commands.constFirst().description();
+                if (description.isEmpty()) {
+                    description = Tr::tr("generating %1")
+                            .arg(outputArtifacts.constFirst().filePath());
+                }
+
+                stream << "build " << outputs.join(QLatin1Char(' ')) << ": "
+                       << (hasJsCommands ? "qbs_javascript" : "qbs_process");
+                for (const QString &input : qAsConst(inputs))
+                    stream << ' ' << input;
+                if (!implicitInputs.empty())
+                    stream << " | " << implicitInputs.join(QLatin1Char(' '));
+                stream << '\n';
+                stream << "  command = " << escapedValue(commandLine) << '\n';
+                stream << "  description = " << escapedValue(description) << '\n';
+                if (!depFilePath.isEmpty()) {
+                    stream << "  depfile = " << escapedValue(depFilePath) << '\n';
+                    stream << "  deps = gcc\n";
+                }
+                stream << '\n';
+            }
+            stream << "build " << productTarget << ": phony";
+            const auto targetArtifacts = productData.targetArtifacts();
+            for (const ArtifactData &ta : targetArtifacts)
+                stream << ' ' << escapedPath(ta.filePath());
+            stream << "\n\n";
+        }
+
+        stream << "build all: phony " << allTargets.join(QLatin1Char(' ')) << '\n';
+        if (!allDefaultTargets.empty())
+            stream << "default " << allDefaultTargets.join(QLatin1Char(' ')) << '\n';
+        if (unscannedCompilations > 0) {
+            logger().qbsWarning() << Tr::tr("No header dependencies are known for "
+                                            "%n compilation(s), presumably because the project "
+                                            "has not been built yet. Ninja will not recompile "
+                                            "them when headers change until the files are "
+                                            "generated again after a build.", nullptr,
+                                            unscannedCompilations);
+        }
+        logger().qbsInfo() << Tr::tr("Ninja file successfully generated at '%1'.")
+                              .arg(ninjaFilePath);
+    }
+}
+
+} // namespace qbs
@@ -0,0 +1 @@
+qbsPluginTarget = ninjagenerator
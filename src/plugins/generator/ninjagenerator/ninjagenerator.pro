@@ -0,0 +1,11 @@
+include(ninjagenerator.pri)
+include(../../plugins.pri)
+
+QT = core
+
+HEADERS += \
+    $$PWD/ninjagenerator.h
+
+SOURCES += \
+    $$PWD/ninjagenerator.cpp \
+    $$PWD/ninjageneratorplugin.cpp
@@ -5,6 +5,6 @@ DEFINES += CPLUSPLUS_NO_PARSER
 QT = core
 
 HEADERS += CPlusPlusForwardDeclarations.h Lexer.h Token.h ../scanner.h \
-           cpp_global.h
+           cpp_global.h includedirectivefinder.h
 SOURCES += Lexer.cpp Token.cpp \
-    cppscanner.cpp
+    cppscanner.cpp includedirectivefinder.cpp
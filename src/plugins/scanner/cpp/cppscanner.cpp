@@ -39,6 +39,7 @@
 
 #include "../scanner.h"
 #include "cpp_global.h"
+#include "includedirectivefinder.h"
 #include "Lexer.h"
 
 using namespace CPlusPlus;
@@ -60,8 +61,11 @@ using namespace CPlusPlus;
 #include <QtCore/qlist.h>
 #include <QtCore/qstring.h>
 
+#include <algorithm>
 #include <cstring>
 #include <memory>
+#include <string_view>
+#include <vector>
 
 struct ScanResult
 {
@@ -112,6 +116,7 @@ struct Opaq
     char *fileContent;
     FileType fileType;
     QList<ScanResult> includedFiles;
+    ModuleDirectives modules;
     bool hasQObjectMacro;
     bool hasPluginMetaDataMacro;
     int currentResultIndex;
@@ -133,8 +138,30 @@ public:
     }
 };
 
-static void scanCppFile(void *opaq, CPlusPlus::Lexer &yylex, bool scanForFileTags,
-                        bool scanForDependencies)
+static void addIncludeDirective(Opaq *opaque, const IncludeDirective &directive)
+{
+    ScanResult scanResult;
+    scanResult.fileName = const_cast<char *>(directive.fileName);
+    scanResult.size = directive.size;
+    scanResult.flags = directive.isLocal ? SC_LOCAL_INCLUDE_FLAG : SC_GLOBAL_INCLUDE_FLAG;
+    opaque->includedFiles.push_back(scanResult);
+}
+
+// Must only be called once the scanning is finished, as the results point into the
+// module names.
+static void addModuleImports(Opaq *opaque)
+{
+    for (const std::string &moduleName : opaque->modules.imports) {
+        ScanResult scanResult;
+        scanResult.fileName = const_cast<char *>(moduleName.data());
+        scanResult.size = int(moduleName.size());
+        scanResult.flags = SC_MODULE_IMPORT_FLAG;
+        opaque->includedFiles.push_back(scanResult);
+    }
+}
+
+static void scanCppFile(void *opaq, CPlusPlus::Lexer &yylex, const char *contentEnd,
+                        bool scanForFileTags, bool scanForDependencies)
 {
     const QLatin1String includeLiteral("include");
     const QLatin1String importLiteral("import");
@@ -174,6 +201,14 @@ static void scanCppFile(void *opaq, CPlusPlus::Lexer &yylex, bool scanForFileTag
                 }
             }
         } else if (tk.is(T_IDENTIFIER)) {
+            const char * const tokenStart = opaque->fileContent + tk.begin();
+            if (scanForDependencies && tk.newline()
+                    && startsModuleDirective(tokenStart, contentEnd)) {
+                std::vector<IncludeDirective> headerUnits;
+                scanModuleDirective(tokenStart, contentEnd, headerUnits, opaque->modules);
+                for (const IncludeDirective &headerUnit : headerUnits)
+                    addIncludeDirective(opaque, headerUnit);
+            }
             if (scanForFileTags) {
                 if (oldTk.is(T_IDENTIFIER) && tc.equals(oldTk, defineLiteral)) {
                     // Someone was clever and redefined Q_OBJECT or Q_PLUGIN_METADATA.
@@ -201,6 +236,25 @@ static void scanCppFile(void *opaq, CPlusPlus::Lexer &yylex, bool scanForFileTag
     }
 }
 
+// The full scan is only needed if one of the macros relevant for moc can occur.
+static bool mayContainMocMacros(const char *begin, const char *end)
+{
+    const std::string_view content(begin, end - begin);
+    for (const char * const macro : {"Q_OBJECT", "Q_GADGET", "Q_NAMESPACE", "Q_PLUGIN_METADATA"}) {
+        if (content.find(macro) != std::string_view::npos)
+            return true;
+    }
+    return false;
+}
+
+static void scanForIncludeDirectives(Opaq *opaque, const char *begin, const char *end)
+{
+    std::vector<IncludeDirective> directives;
+    findIncludeDirectives(begin, end, directives, &opaque->modules);
+    for (const IncludeDirective &directive : directives)
+        addIncludeDirective(opaque, directive);
+}
+
 static void *openScanner(const unsigned short *filePath, const char *fileTags, int flags)
 {
     std::unique_ptr<Opaq> opaque(new Opaq);
@@ -258,8 +312,14 @@ static void *openScanner(const unsigned short *filePath, const char *fileTags, i
         mapl -= 3;
     }
 
-    CPlusPlus::Lexer lex(opaque->fileContent, opaque->fileContent + mapl);
-    scanCppFile(opaque.get(), lex, flags & ScanForFileTagsFlag, flags & ScanForDependenciesFlag);
+    const char * const contentEnd = opaque->fileContent + mapl;
+    if ((flags & ScanForFileTagsFlag) && mayContainMocMacros(opaque->fileContent, contentEnd)) {
+        CPlusPlus::Lexer lex(opaque->fileContent, contentEnd);
+        scanCppFile(opaque.get(), lex, contentEnd, true, flags & ScanForDependenciesFlag);
+    } else if (flags & ScanForDependenciesFlag) {
+        scanForIncludeDirectives(opaque.get(), opaque->fileContent, contentEnd);
+    }
+    addModuleImports(opaque.get());
     return opaque.release();
 }
 
@@ -284,6 +344,47 @@ static const char *next(void *opaq, int *size, int *flags)
     return nullptr;
 }
 
+struct BatchResult
+{
+    std::vector<char> arena;
+    std::vector<ScannedDependency> dependencies;
+    std::vector<int> fileOffsets;
+    std::vector<int> fileErrors;
+};
+
+static void *scanBatch(const unsigned short * const *filePaths, int fileCount,
+                       const char *fileTags, int flags, ScanBatchResult *result)
+{
+    const auto batch = new BatchResult;
+    batch->fileOffsets.reserve(fileCount + 1);
+    batch->fileErrors.reserve(fileCount);
+    for (int i = 0; i < fileCount; ++i) {
+        batch->fileOffsets.push_back(int(batch->dependencies.size()));
+        const std::unique_ptr<Opaq> opaque(static_cast<Opaq *>(
+                openScanner(filePaths[i], fileTags, flags & ScanForDependenciesFlag)));
+        batch->fileErrors.push_back(opaque ? 0 : 1);
+        if (!opaque)
+            continue;
+        for (const ScanResult &scanResult : qAsConst(opaque->includedFiles)) {
+            const int size = std::max(scanResult.size, 0);
+            batch->dependencies.push_back({int(batch->arena.size()), size, scanResult.flags});
+            batch->arena.insert(batch->arena.end(), scanResult.fileName,
+                                scanResult.fileName + size);
+        }
+    }
+    batch->fileOffsets.push_back(int(batch->dependencies.size()));
+    result->arena = batch->arena.data();
+    result->dependencies = batch->dependencies.data();
+    result->fileOffsets = batch->fileOffsets.data();
+    result->fileErrors = batch->fileErrors.data();
+    return batch;
+}
+
+static void releaseBatch(void *batch)
+{
+    delete static_cast<BatchResult *>(batch);
+}
+
 static const char **additionalFileTags(void *opaq, int *size)
 {
     static const char *thMocCpp[] = { "moc_cpp" };
@@ -316,7 +417,10 @@ ScannerPlugin includeScanner =
     closeScanner,
     next,
     additionalFileTags,
-    ScannerUsesCppIncludePaths | ScannerRecursiveDependencies
+    ScannerUsesCppIncludePaths | ScannerRecursiveDependencies | ScannerIsThreadSafe
+            | ScannerSupportsBatchScanning,
+    scanBatch,
+    releaseBatch
 };
 
 ScannerPlugin *cppScanners[] = { &includeScanner, nullptr };
@@ -0,0 +1,404 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qbs.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "includedirectivefinder.h"
+
+#include "Lexer.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+
+using namespace CPlusPlus;
+
+// Outside of comments and literals, these are the only bytes that can affect how the
+// following content is tokenized, or whether a '#' starts a directive. Everything in between
+// is plain code that we do not need to look at in detail.
+static bool isSpecialChar(char c)
+{
+    switch (c) {
+    case '\n': case '#': case '/': case '"': case '\'': case '\\':
+        return true;
+    default:
+        return false;
+    }
+}
+
+static std::uint64_t repeatedByte(char c)
+{
+    return 0x0101010101010101ULL * static_cast<unsigned char>(c);
+}
+
+// Non-zero iff at least one of the bytes in word is zero.
+static std::uint64_t zeroByteBits(std::uint64_t word)
+{
+    return (word - 0x0101010101010101ULL) & ~word & 0x8080808080808080ULL;
+}
+
+static bool chunkContainsSpecialChar(const char *chunk)
+{
+    static const std::uint64_t patterns[] = {
+        repeatedByte('\n'), repeatedByte('#'), repeatedByte('/'),
+        repeatedByte('"'), repeatedByte('\''), repeatedByte('\\')
+    };
+    std::uint64_t word;
+    std::memcpy(&word, chunk, sizeof word);
+    std::uint64_t bits = 0;
+    for (const std::uint64_t pattern : patterns)
+        bits |= zeroByteBits(word ^ pattern);
+    return bits != 0;
+}
+
+static const char *findSpecialChar(const char *p, const char *end)
+{
+    const int chunkSize = sizeof(std::uint64_t);
+    while (true) {
+        while (end - p >= chunkSize && !chunkContainsSpecialChar(p))
+            p += chunkSize;
+        const char * const chunkEnd = std::min(p + chunkSize, end);
+        for (; p < chunkEnd; ++p) {
+            if (isSpecialChar(*p))
+                return p;
+        }
+        if (p == end)
+            return end;
+    }
+}
+
+static bool isWhiteSpaceOnly(const char *begin, const char *end)
+{
+    return std::all_of(begin, end, [](char c) { return std::isspace(static_cast<unsigned char>(c)); });
+}
+
+// Whether the lexer starts a token at pos, given that it starts one at tokenStart and there are
+// no special characters in between. This is needed to tell wide literals from identifiers
+// and numbers ending in 'L'.
+static bool startsToken(const char *tokenStart, const char *pos, const char *end)
+{
+    const auto isIdentifierChar = [](unsigned char c) { return std::isalnum(c) || c == '_' || c == '$'; };
+    const auto skipNumber = [end](const char *p) {
+        while (p < end) {
+            if (*p == 'e' || *p == 'E') {
+                if (++p < end && (*p == '+' || *p == '-'))
+                    ++p;
+            } else if (std::isalnum(static_cast<unsigned char>(*p)) || *p == '.') {
+                ++p;
+            } else {
+                break;
+            }
+        }
+        return p;
+    };
+
+    const char *p = tokenStart;
+    while (p < pos) {
+        const auto c = static_cast<unsigned char>(*p);
+        if (std::isalpha(c) || c == '_' || c == '$') {
+            while (++p < end && isIdentifierChar(static_cast<unsigned char>(*p)))
+                ;
+        } else if (std::isdigit(c)) {
+            p = skipNumber(p + 1);
+        } else if (c == '.' && p + 1 < end && std::isdigit(static_cast<unsigned char>(p[1]))) {
+            p = skipNumber(p + 1);
+        } else {
+            ++p; // White space or operator; the latter never contain letters.
+        }
+    }
+    return p == pos;
+}
+
+static const char *skipLiteral(const char *p, const char *end, char quote, bool isWide)
+{
+    while (p < end && *p != quote) {
+        if (*p == '\n' && !isWide)
+            break;
+        if (*p == '\\' && p + 1 < end)
+            ++p;
+        ++p;
+    }
+    if (p < end && *p == quote)
+        ++p;
+    return p;
+}
+
+static const char *skipBlockComment(const char *p, const char *end)
+{
+    while (true) {
+        const auto star = static_cast<const char *>(std::memchr(p, '*', end - p));
+        if (!star)
+            return end;
+        if (star + 1 < end && star[1] == '/')
+            return star + 2;
+        p = star + 1;
+    }
+}
+
+// Tokenizes the directive starting at pos exactly like the full scan in cppscanner.cpp does.
+// Returns the position after the last token looked at.
+static const char *scanDirective(const char *pos, const char *end,
+                                 std::vector<IncludeDirective> &directives)
+{
+    const auto equals = [pos](const Token &tk, const char *literal) {
+        const auto length = std::strlen(literal);
+        return tk.length() == length && std::memcmp(pos + tk.begin(), literal, length) == 0;
+    };
+
+    Lexer lexer(pos, end);
+    Token tk;
+    lexer(&tk); // The '#'.
+    lexer(&tk);
+    if (!tk.newline() && tk.is(T_IDENTIFIER)
+            && (equals(tk, "include") || equals(tk, "import"))) {
+        lexer.setScanAngleStringLiteralTokens(true);
+        lexer(&tk);
+        if (!tk.newline() && (tk.is(T_STRING_LITERAL) || tk.is(T_ANGLE_STRING_LITERAL))) {
+            IncludeDirective directive;
+            directive.fileName = pos + tk.begin() + 1;
+            directive.size = int(tk.length() - 2);
+            directive.isLocal = tk.is(T_STRING_LITERAL);
+            directives.push_back(directive);
+        }
+    }
+    return lexer.tokenEnd();
+}
+
+static bool continuesIdentifier(char c)
+{
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '$';
+}
+
+bool startsModuleDirective(const char *pos, const char *end)
+{
+    for (const char * const keyword : {"export", "import", "module"}) {
+        const auto length = std::strlen(keyword);
+        if (size_t(end - pos) >= length && std::memcmp(pos, keyword, length) == 0
+                && (size_t(end - pos) == length || !continuesIdentifier(pos[length]))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Module and import declarations are directives that can only span one line, like the
+// preprocessor directives. Anything that does not parse as one is left alone.
+const char *scanModuleDirective(const char *pos, const char *end,
+                                std::vector<IncludeDirective> &directives,
+                                ModuleDirectives &modules)
+{
+    const auto equals = [pos](const Token &tk, const char *literal) {
+        const auto length = std::strlen(literal);
+        return tk.length() == length && std::memcmp(pos + tk.begin(), literal, length) == 0;
+    };
+
+    Lexer lexer(pos, end);
+    Token tk;
+    const char *consumedEnd = pos;
+    const auto consume = [&] { consumedEnd = pos + tk.begin() + tk.length(); };
+    const auto next = [&] {
+        lexer(&tk);
+        return !tk.newline() && tk.isNot(T_EOF_SYMBOL);
+    };
+
+    // On success, tk is the token after the name, which might be on the next line.
+    const auto readModuleName = [&](std::string &name) {
+        if (tk.isNot(T_IDENTIFIER))
+            return false;
+        name.assign(pos + tk.begin(), tk.length());
+        consume();
+        while (next() && tk.is(T_DOT)) {
+            if (!next() || tk.isNot(T_IDENTIFIER))
+                return false;
+            name += '.';
+            name.append(pos + tk.begin(), tk.length());
+            consume();
+        }
+        return true;
+    };
+
+    // Skips attributes, if any, and consumes the terminating semicolon.
+    const auto finish = [&] {
+        while (!tk.newline() && tk.isNot(T_EOF_SYMBOL) && tk.isNot(T_SEMICOLON))
+            lexer(&tk);
+        if (tk.newline() || tk.isNot(T_SEMICOLON))
+            return false;
+        consume();
+        return true;
+    };
+
+    lexer(&tk);
+    bool isExport = false;
+    if (equals(tk, "export")) {
+        consume();
+        if (!next())
+            return consumedEnd;
+        isExport = true;
+    }
+
+    if (tk.is(T_IDENTIFIER) && equals(tk, "module")) {
+        consume();
+        if (!next())
+            return consumedEnd;
+        if (tk.is(T_SEMICOLON)) { // Start of the global module fragment.
+            consume();
+            return consumedEnd;
+        }
+        std::string name;
+        std::string partition;
+        if (!readModuleName(name))
+            return consumedEnd;
+        if (!tk.newline() && tk.is(T_COLON) && (!next() || !readModuleName(partition)))
+            return consumedEnd;
+        if (!finish())
+            return consumedEnd;
+        modules.declaredModule = name;
+
+        // A module implementation unit implicitly imports the primary module interface.
+        if (!isExport && partition.empty())
+            modules.imports.push_back(name);
+        return consumedEnd;
+    }
+
+    if (tk.is(T_IDENTIFIER) && equals(tk, "import")) {
+        consume();
+        lexer.setScanAngleStringLiteralTokens(true);
+        const bool hasOperand = next();
+        lexer.setScanAngleStringLiteralTokens(false);
+        if (!hasOperand)
+            return consumedEnd;
+        if (tk.is(T_STRING_LITERAL) || tk.is(T_ANGLE_STRING_LITERAL)) {
+            IncludeDirective directive;
+            directive.fileName = pos + tk.begin() + 1;
+            directive.size = int(tk.length() - 2);
+            directive.isLocal = tk.is(T_STRING_LITERAL);
+            consume();
+            lexer(&tk);
+            if (finish())
+                directives.push_back(directive);
+            return consumedEnd;
+        }
+        std::string name;
+        if (tk.is(T_COLON)) {
+            std::string partition;
+            if (!next() || !readModuleName(partition) || modules.declaredModule.empty())
+                return consumedEnd;
+            name = modules.declaredModule + ':' + partition;
+        } else if (!readModuleName(name)) {
+            return consumedEnd;
+        }
+        if (finish())
+            modules.imports.push_back(name);
+    }
+    return consumedEnd;
+}
+
+void findIncludeDirectives(const char *begin, const char *end,
+                           std::vector<IncludeDirective> &directives, ModuleDirectives *modules)
+{
+    // The lexer stops at the first null byte.
+    if (const auto nullByte = static_cast<const char *>(std::memchr(begin, 0, end - begin)))
+        end = nullByte;
+
+    // Corresponds to the lexer's "newline" token flag: No token since the last line break.
+    bool atLineStart = true;
+
+    const char *p = begin; // Always at a position where the lexer would start a token.
+    while (p < end) {
+        const char * const specialChar = findSpecialChar(p, end);
+        if (atLineStart && !isWhiteSpaceOnly(p, specialChar)) {
+            atLineStart = false;
+            if (modules) {
+                const char *tokenStart = p;
+                while (std::isspace(static_cast<unsigned char>(*tokenStart)))
+                    ++tokenStart;
+                if (startsModuleDirective(tokenStart, end)) {
+                    p = scanModuleDirective(tokenStart, end, directives, *modules);
+                    continue;
+                }
+            }
+        }
+        if (specialChar == end)
+            break;
+        const char * const plainCodeStart = p;
+        p = specialChar;
+        switch (*p) {
+        case '\n':
+            atLineStart = true;
+            ++p;
+            break;
+        case '#':
+            if (p + 1 < end && p[1] == '#')
+                p += 2;
+            else if (atLineStart)
+                p = scanDirective(p, end, directives);
+            else
+                ++p;
+            atLineStart = false;
+            break;
+        case '/':
+            if (p + 1 < end && p[1] == '/') {
+                const auto lineEnd = static_cast<const char *>(std::memchr(p, '\n', end - p));
+                p = lineEnd ? lineEnd : end;
+            } else if (p + 1 < end && p[1] == '*') {
+                p = skipBlockComment(p + 2, end);
+            } else {
+                atLineStart = false;
+                ++p;
+            }
+            break;
+        case '"':
+        case '\'': {
+            const bool isWide = p > plainCodeStart && p[-1] == 'L'
+                    && startsToken(plainCodeStart, p - 1, end);
+            p = skipLiteral(p + 1, end, *p, isWide);
+            atLineStart = false;
+            break;
+        }
+        case '\\': // Line continuation. The backslash itself does not form a token.
+            ++p;
+            while (p < end && *p != '\n' && std::isspace(static_cast<unsigned char>(*p)))
+                ++p;
+            if (p < end && *p == '\n') {
+                atLineStart = false;
+                ++p;
+            }
+            break;
+        }
+    }
+}
@@ -0,0 +1,79 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qbs.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QBS_CPPSCANNER_INCLUDEDIRECTIVEFINDER_H
+#define QBS_CPPSCANNER_INCLUDEDIRECTIVEFINDER_H
+
+#include <string>
+#include <vector>
+
+struct IncludeDirective
+{
+    const char *fileName = nullptr; // Points into the scanned content; not null-terminated.
+    int size = 0;
+    bool isLocal = false;           // "file" rather than <file>
+};
+
+// The C++20 module declaration and the named modules imported by a file.
+// Partitions are spelled "module:partition".
+struct ModuleDirectives
+{
+    std::string declaredModule;
+    std::vector<std::string> imports;
+};
+
+// Finds the #include and #import directives in the given content. The result is the same
+// as if the content was run through the CPlusPlus::Lexer token by token, but only the
+// directive lines are actually tokenized; the rest is skipped in word-sized chunks.
+// If modules is not null, module and import declarations are collected as well.
+// Header unit imports are reported as include directives.
+void findIncludeDirectives(const char *begin, const char *end,
+                           std::vector<IncludeDirective> &directives,
+                           ModuleDirectives *modules = nullptr);
+
+// Whether pos starts with one of the keywords that can begin a module or import declaration.
+bool startsModuleDirective(const char *pos, const char *end);
+
+// Parses the module or import declaration starting at pos, which must be at the start
+// of a line. Returns the position after the last token that was part of it.
+const char *scanModuleDirective(const char *pos, const char *end,
+                                std::vector<IncludeDirective> &directives,
+                                ModuleDirectives &modules);
+
+#endif // QBS_CPPSCANNER_INCLUDEDIRECTIVEFINDER_H
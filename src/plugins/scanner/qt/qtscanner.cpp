@@ -176,7 +176,7 @@ ScannerPlugin qrcScanner =
     closeScannerQrc,
     nextQrc,
     additionalFileTagsQrc,
-    NoScannerFlags
+    ScannerIsThreadSafe
 };
 
 ScannerPlugin *qtScanners[] = {&qrcScanner, nullptr};
@@ -47,6 +47,10 @@ extern "C" {
 #define SC_LOCAL_INCLUDE_FLAG   0x1
 #define SC_GLOBAL_INCLUDE_FLAG  0x2
 
+// The result is not a file name, but the name of an imported C++20 module.
+// Module partitions are reported as "module:partition".
+#define SC_MODULE_IMPORT_FLAG   0x4
+
 enum OpenScannerFlags
 {
     ScanForDependenciesFlag = 0x01,
@@ -81,11 +85,63 @@ typedef const char *(*scanNext_f)           (void *opaq, int *size, int *flags);
   */
 typedef const char** (*scanAdditionalFileTags_f) (void *opaq, int *size);
 
+/**
+  * A dependency found by scanBatch_f.
+  * The file name is not null-terminated; it is located at
+  * ScanBatchResult::arena + offset and is size bytes long.
+  * The flags are the same as the ones returned by scanNext_f.
+  */
+struct ScannedDependency
+{
+    int offset;
+    int size;
+    int flags;
+};
+
+/**
+  * The results of scanning a batch of files.
+  * The dependencies of the i-th file are the entries
+  * dependencies[fileOffsets[i]] up to, but not including, dependencies[fileOffsets[i + 1]].
+  * The fileOffsets array has fileCount + 1 entries.
+  * A non-zero entry in fileErrors means the respective file could not be scanned,
+  * which is the equivalent of scanOpen_f returning null.
+  */
+struct ScanBatchResult
+{
+    const char *arena;
+    const struct ScannedDependency *dependencies;
+    const int *fileOffsets;
+    const int *fileErrors;
+};
+
+/**
+  * Scans all the given files for dependencies in one go.
+  * The file paths and tags are as for scanOpen_f; the file tags apply to all files.
+  * Fills in the result and returns a handle that owns the memory it refers to.
+  * The handle must be released with scanReleaseBatch_f.
+  */
+typedef void *(*scanBatch_f) (const unsigned short * const *filePaths, int fileCount,
+                              const char *fileTags, int flags, struct ScanBatchResult *result);
+
+/**
+  * Releases a handle returned by scanBatch_f.
+  */
+typedef void  (*scanReleaseBatch_f)         (void *batch);
+
 enum ScannerFlags
 {
     NoScannerFlags = 0x00,
     ScannerUsesCppIncludePaths = 0x01,
-    ScannerRecursiveDependencies = 0x02
+    ScannerRecursiveDependencies = 0x02,
+
+    // All functions of the plugin may be called concurrently from different threads,
+    // as long as each handle is only used by one thread at a time.
+    ScannerIsThreadSafe = 0x04,
+
+    // The plugin provides the scanBatch and releaseBatch members. Plugins built against
+    // older versions of this header do not have them, so they must not be accessed
+    // unless this flag is set.
+    ScannerSupportsBatchScanning = 0x08
 };
 
 class ScannerPlugin
@@ -98,6 +154,8 @@ public:
     scanNext_f  next;
     scanAdditionalFileTags_f additionalFileTags;
     int flags;
+    scanBatch_f scanBatch;
+    scanReleaseBatch_f releaseBatch;
 };
 
 #ifdef __cplusplus
@@ -41,9 +41,13 @@
 
 #include <QtCore/qcoreapplication.h>
 #include <QtCore/qdir.h>
+#include <QtCore/qelapsedtimer.h>
 #include <QtCore/qeventloop.h>
 #include <QtCore/qfile.h>
 #include <QtCore/qfileinfo.h>
+#include <QtCore/qloggingcategory.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qregularexpression.h>
 #include <QtCore/qstringlist.h>
 #include <QtCore/qthread.h>
 #include <QtCore/qtimer.h>
@@ -114,6 +118,56 @@ public:
     void handleTaskStart(const QString &task) { taskDescriptions += task; }
 };
 
+// Collects the names of the products that the executor reports as skipped.
+class SkippedProductsRecorder
+{
+public:
+    SkippedProductsRecorder()
+    {
+        QLoggingCategory::setFilterRules(QStringLiteral("qbs.exec.debug=true"));
+        m_oldHandler = qInstallMessageHandler(handleMessage);
+    }
+    ~SkippedProductsRecorder()
+    {
+        qInstallMessageHandler(m_oldHandler);
+        QLoggingCategory::setFilterRules(QString());
+    }
+
+    QStringList takeProducts()
+    {
+        QMutexLocker locker(&m_mutex);
+        QStringList products = std::move(m_products);
+        m_products.clear();
+        products.sort();
+        return products;
+    }
+
+private:
+    static void handleMessage(QtMsgType type, const QMessageLogContext &context,
+                              const QString &message)
+    {
+        static const QRegularExpression regexp(
+                    QStringLiteral("^product \"(.+)\" is unchanged, skipping$"));
+        if (qstrcmp(context.category, "qbs.exec") == 0) {
+            const QRegularExpressionMatch match = regexp.match(message);
+            if (match.hasMatch()) {
+                QMutexLocker locker(&m_mutex);
+                m_products << match.captured(1);
+            }
+            return;
+        }
+        m_oldHandler(type, context, message);
+    }
+
+    static QtMessageHandler m_oldHandler;
+    static QMutex m_mutex;
+    static QStringList m_products;
+};
+
+QtMessageHandler SkippedProductsRecorder::m_oldHandler = nullptr;
+QMutex SkippedProductsRecorder::m_mutex;
+QStringList SkippedProductsRecorder::m_products;
+
 
 static void removeBuildDir(const qbs::SetupProjectParameters &params)
 {
@@ -495,6 +549,32 @@ void TestApi::buildSingleFile()
              qPrintable(receiver.descriptions));
 }
 
+void TestApi::cancelDuringRuleApplication()
+{
+    const qbs::SetupProjectParameters setupParams
+            = defaultSetupParameters("cancel-during-rule-application");
+    removeBuildDir(setupParams);
+    const std::unique_ptr<qbs::SetupProjectJob> setupJob(
+                qbs::Project().setupProject(setupParams, m_logSink, nullptr));
+    waitForFinished(setupJob.get());
+    VERIFY_NO_ERROR(setupJob->error());
+    qbs::Project project = setupJob->project();
+
+    // Applying the rule to all inputs takes ten seconds. The cancel request must be honored
+    // while a prepare script is running and between two rule applications.
+    const std::unique_ptr<qbs::BuildJob> buildJob(project.buildAllProducts(qbs::BuildOptions()));
+    QElapsedTimer timer;
+    QTimer::singleShot(1000, buildJob.get(), [&buildJob, &timer] {
+        timer.start();
+        buildJob->cancel();
+    });
+    QVERIFY(waitForFinished(buildJob.get(), testTimeoutInMsecs()));
+    QVERIFY(timer.isValid());
+    QVERIFY2(timer.elapsed() < 2000, qPrintable(QString::number(timer.elapsed())));
+    QVERIFY2(buildJob->error().toString().toLower().contains("cancel"),
+             qPrintable(buildJob->error().toString()));
+}
+
 void TestApi::canonicalToolchainList()
 {
     // All the known toolchain lists should be equal
@@ -951,6 +1031,39 @@ void TestApi::changeDependentLib()
     VERIFY_NO_ERROR(errorInfo);
 }
 
+void TestApi::changedFilesComplete()
+{
+    BuildDescriptionReceiver bdr;
+    qbs::ErrorInfo errorInfo = doBuildProject("changed-files-complete", &bdr);
+    VERIFY_NO_ERROR(errorInfo);
+    QVERIFY2(bdr.descriptions.contains("compiling file.cpp"), qPrintable(bdr.descriptions));
+    QVERIFY2(bdr.descriptions.contains("compiling main.cpp"), qPrintable(bdr.descriptions));
+
+    // The list of changed files is declared to be complete, so the change to main.cpp
+    // must go unnoticed.
+    WAIT_FOR_NEW_TIMESTAMP();
+    touch("main.cpp");
+    qbs::BuildOptions options;
+    options.setChangedFilesComplete(true);
+    bdr.descriptions.clear();
+    errorInfo = doBuildProject("changed-files-complete", &bdr, nullptr, nullptr, options);
+    VERIFY_NO_ERROR(errorInfo);
+    QVERIFY2(!bdr.descriptions.contains("compiling"), qPrintable(bdr.descriptions));
+
+    options.setChangedFiles({QFileInfo("file.cpp").absoluteFilePath()});
+    bdr.descriptions.clear();
+    errorInfo = doBuildProject("changed-files-complete", &bdr, nullptr, nullptr, options);
+    VERIFY_NO_ERROR(errorInfo);
+    QVERIFY2(bdr.descriptions.contains("compiling file.cpp"), qPrintable(bdr.descriptions));
+    QVERIFY2(!bdr.descriptions.contains("compiling main.cpp"), qPrintable(bdr.descriptions));
+
+    // Without the journal, all timestamps are checked again.
+    bdr.descriptions.clear();
+    errorInfo = doBuildProject("changed-files-complete", &bdr);
+    VERIFY_NO_ERROR(errorInfo);
+    QVERIFY2(bdr.descriptions.contains("compiling main.cpp"), qPrintable(bdr.descriptions));
+}
+
 void TestApi::enableAndDisableProduct()
 {
     BuildDescriptionReceiver bdr;
@@ -2784,6 +2897,84 @@ void TestApi::runEnvForDisabledProduct()
              qPrintable(runError.toString()));
 }
 
+void TestApi::skipUnchangedProducts()
+{
+    SkippedProductsRecorder skippedProducts;
+    BuildDescriptionReceiver bdr;
+    qbs::ErrorInfo errorInfo = doBuildProject("skip-unchanged-products", &bdr);
+    VERIFY_NO_ERROR(errorInfo);
+    QVERIFY2(bdr.descriptions.contains("compiling lib.cpp"), qPrintable(bdr.descriptions));
+    QVERIFY2(bdr.descriptions.contains("compiling main.cpp"), qPrintable(bdr.descriptions));
+    QCOMPARE(skippedProducts.takeProducts(), QStringList());
+
+    bdr.descriptions.clear();
+    errorInfo = doBuildProject("skip-unchanged-products", &bdr);
+    VERIFY_NO_ERROR(errorInfo);
+    QVERIFY2(!bdr.descriptions.contains("compiling"), qPrintable(bdr.descriptions));
+    QVERIFY2(!bdr.descriptions.contains("linking"), qPrintable(bdr.descriptions));
+    QCOMPARE(skippedProducts.takeProducts(), QStringList({"app", "lib", "other"}));
+
+    // A change in the library must still be seen by the depending product.
+    WAIT_FOR_NEW_TIMESTAMP();
+    touch("lib.cpp");
+    bdr.descriptions.clear();
+    errorInfo = doBuildProject("skip-unchanged-products", &bdr);
+    VERIFY_NO_ERROR(errorInfo);
+    QVERIFY2(bdr.descriptions.contains("compiling lib.cpp"), qPrintable(bdr.descriptions));
+    QVERIFY2(!bdr.descriptions.contains("compiling main.cpp"), qPrintable(bdr.descriptions));
+    QVERIFY2(bdr.descriptions.contains("linking"), qPrintable(bdr.descriptions));
+    QCOMPARE(skippedProducts.takeProducts(), QStringList("other"));
+
+    WAIT_FOR_NEW_TIMESTAMP();
+    touch("lib.h");
+    bdr.descriptions.clear();
+    errorInfo = doBuildProject("skip-unchanged-products", &bdr);
+    VERIFY_NO_ERROR(errorInfo);
+    QVERIFY2(bdr.descriptions.contains("compiling lib.cpp"), qPrintable(bdr.descriptions));
+    QVERIFY2(bdr.descriptions.contains("compiling main.cpp"), qPrintable(bdr.descriptions));
+    QCOMPARE(skippedProducts.takeProducts(), QStringList("other"));
+
+    // A changed file dependency only affects the products that use it.
+    WAIT_FOR_NEW_TIMESTAMP();
+    touch("unlisted.h");
+    bdr.descriptions.clear();
+    errorInfo = doBuildProject("skip-unchanged-products", &bdr);
+    VERIFY_NO_ERROR(errorInfo);
+    QVERIFY2(bdr.descriptions.contains("compiling other.cpp"), qPrintable(bdr.descriptions));
+    QVERIFY2(!bdr.descriptions.contains("compiling lib.cpp"), qPrintable(bdr.descriptions));
+    QCOMPARE(skippedProducts.takeProducts(), QStringList({"app", "lib"}));
+
+    // Building only the library must not make the application look up-to-date.
+    WAIT_FOR_NEW_TIMESTAMP();
+    touch("lib.cpp");
+    {
+        const qbs::SetupProjectParameters params
+                = defaultSetupParameters("skip-unchanged-products");
+        const std::unique_ptr<qbs::SetupProjectJob> setupJob(
+                    qbs::Project().setupProject(params, m_logSink, nullptr));
+        waitForFinished(setupJob.get());
+        VERIFY_NO_ERROR(setupJob->error());
+        qbs::Project project = setupJob->project();
+        QList<qbs::ProductData> libProducts;
+        for (const qbs::ProductData &p : project.projectData().allProducts()) {
+            if (p.name() == "lib")
+                libProducts << p;
+        }
+        QCOMPARE(libProducts.size(), 1);
+        const std::unique_ptr<qbs::BuildJob> buildJob(
+                    project.buildSomeProducts(libProducts, qbs::BuildOptions()));
+        waitForFinished(buildJob.get());
+        VERIFY_NO_ERROR(buildJob->error());
+    }
+    skippedProducts.takeProducts();
+    bdr.descriptions.clear();
+    errorInfo = doBuildProject("skip-unchanged-products", &bdr);
+    VERIFY_NO_ERROR(errorInfo);
+    QVERIFY2(!bdr.descriptions.contains("compiling lib.cpp"), qPrintable(bdr.descriptions));
+    QVERIFY2(bdr.descriptions.contains("linking"), qPrintable(bdr.descriptions));
+    QCOMPARE(skippedProducts.takeProducts(), QStringList({"lib", "other"}));
+}
+
 void TestApi::softDependency()
 {
     const qbs::ErrorInfo errorInfo = doBuildProject("soft-dependency");
@@ -68,11 +68,13 @@ private slots:
     void buildProjectDryRun();
     void buildProjectDryRun_data();
     void buildSingleFile();
+    void cancelDuringRuleApplication();
     void canonicalToolchainList();
 #ifdef QBS_ENABLE_PROJECT_FILE_UPDATES
     void changeContent();
 #endif
     void changeDependentLib();
+    void changedFilesComplete();
     void checkOutputs();
     void checkOutputs_data();
     void commandExtraction();
@@ -141,6 +143,7 @@ private slots:
     void restoredWarnings();
     void ruleConflict();
     void runEnvForDisabledProduct();
+    void skipUnchangedProducts();
     void softDependency();
     void sourceFileInBuildDir();
     void subProjects();
@@ -0,0 +1,4 @@
+#include <string>
+#include <vector>
+
+int f1() { return int(std::vector<std::string>(1).size()); }
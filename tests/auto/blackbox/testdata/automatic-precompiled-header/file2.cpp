@@ -0,0 +1,4 @@
+#include <string>
+#include <vector>
+
+int f2() { return int(std::vector<std::string>(2).size()); }
@@ -0,0 +1,7 @@
+#include <string>
+#include <vector>
+
+int f1();
+int f2();
+
+int main() { return f1() + f2() - 3; }
@@ -0,0 +1,7 @@
+#if defined(_WIN32) || defined(WIN32)
+#   define EXPORT __declspec(dllexport)
+#else
+#   define EXPORT
+#endif
+
+EXPORT int helperValue() { return 1; }
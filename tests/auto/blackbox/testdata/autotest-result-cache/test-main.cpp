@@ -0,0 +1,7 @@
+#include <iostream>
+
+int main()
+{
+    std::cout << "i am the test app" << std::endl;
+    return 0;
+}
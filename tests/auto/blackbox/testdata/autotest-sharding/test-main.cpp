@@ -0,0 +1,14 @@
+#include <cstdlib>
+#include <iostream>
+
+int main()
+{
+    const char * const index = std::getenv("MY_SHARD_INDEX");
+    const char * const count = std::getenv("MY_SHARD_COUNT");
+    if (!index || !count) {
+        std::cout << "running all shards" << std::endl;
+        return 0;
+    }
+    std::cout << "running shard " << index << " of " << count << std::endl;
+    return 0;
+}
@@ -0,0 +1 @@
+#define GREETER_VERSION 1
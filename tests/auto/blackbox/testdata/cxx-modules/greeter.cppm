@@ -0,0 +1,9 @@
+module;
+
+#include "config.h"
+
+export module greeter;
+
+export import :numbers;
+
+export int answer();
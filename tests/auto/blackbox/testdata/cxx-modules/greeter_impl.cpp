@@ -0,0 +1,3 @@
+module greeter;
+
+int answer() { return base() + 2; }
@@ -0,0 +1,6 @@
+import greeter;
+
+int main()
+{
+    return answer() == 42 ? 0 : 1;
+}
@@ -0,0 +1,3 @@
+export module greeter:numbers;
+
+export int base() { return 40; }
@@ -0,0 +1,8 @@
+int other();
+int special();
+extern "C" int util();
+
+int main()
+{
+    return other() + special() + util();
+}
@@ -0,0 +1,3 @@
+export module m;
+
+export int moduleFunction() { return 0; }
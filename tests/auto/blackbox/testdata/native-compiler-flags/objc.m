@@ -0,0 +1 @@
+int objcFunction(void) { return 0; }
@@ -0,0 +1 @@
+int objcppFunction() { return 0; }
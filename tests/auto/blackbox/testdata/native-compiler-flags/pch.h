@@ -0,0 +1 @@
+#include <cstddef>
@@ -0,0 +1,5 @@
+#ifndef PRODUCT_DEFINE
+#error "missing product define"
+#endif
+
+int special() { return 0; }
@@ -0,0 +1 @@
+#define EXIT_CODE 0
@@ -0,0 +1,11 @@
+#include "exitcode.h"
+
+#include <greeting.h>
+
+#include <iostream>
+
+int main()
+{
+    std::cout << GREETING << std::endl;
+    return EXIT_CODE;
+}
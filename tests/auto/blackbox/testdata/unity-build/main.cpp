@@ -0,0 +1,8 @@
+int f1();
+int f2();
+int separate();
+int uncombinable();
+
+static int i = 0;
+
+int main() { return i + f1() + f2() + separate() + uncombinable() - 7; }
@@ -0,0 +1,4 @@
+#ifndef SEPARATE
+#error "SEPARATE not defined"
+#endif
+int separate() { return 3; }
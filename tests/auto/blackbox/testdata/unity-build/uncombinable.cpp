@@ -0,0 +1,2 @@
+static int i = 1;
+int uncombinable() { return i; }
@@ -1866,6 +1866,38 @@ void TestBlackbox::cxxLanguageVersion_data()
                             std::make_pair(QString("msvc-new"), QString("/std:"))});
 }
 
+void TestBlackbox::cxxModules()
+{
+    QDir::setCurrent(testDataDir + "/cxx-modules");
+    QCOMPARE(runQbs(QbsRunParameters("resolve")), 0);
+    if (!m_qbsStdout.contains("compiler supports modules"))
+        QSKIP("Compiler does not support C++20 modules");
+
+    // Module interfaces are compiled before the files importing them.
+    QCOMPARE(runQbs(), 0);
+    const int numbersIndex = m_qbsStdout.indexOf("compiling numbers.cppm");
+    const int interfaceIndex = m_qbsStdout.indexOf("compiling greeter.cppm");
+    QVERIFY2(numbersIndex != -1 && interfaceIndex > numbersIndex, m_qbsStdout.constData());
+    QVERIFY2(m_qbsStdout.indexOf("compiling greeter_impl.cpp") > interfaceIndex,
+             m_qbsStdout.constData());
+    QVERIFY2(m_qbsStdout.indexOf("compiling main.cpp") > interfaceIndex, m_qbsStdout.constData());
+
+    WAIT_FOR_NEW_TIMESTAMP();
+    touch("greeter_impl.cpp");
+    QCOMPARE(runQbs(), 0);
+    QVERIFY2(m_qbsStdout.contains("compiling greeter_impl.cpp"), m_qbsStdout.constData());
+    QVERIFY2(!m_qbsStdout.contains("compiling greeter.cppm"), m_qbsStdout.constData());
+    QVERIFY2(!m_qbsStdout.contains("compiling main.cpp"), m_qbsStdout.constData());
+
+    WAIT_FOR_NEW_TIMESTAMP();
+    REPLACE_IN_FILE("greeter.cppm", "export int answer();",
+                    "export int answer();\nexport int question();");
+    QCOMPARE(runQbs(), 0);
+    QVERIFY2(m_qbsStdout.contains("compiling greeter.cppm"), m_qbsStdout.constData());
+    QVERIFY2(m_qbsStdout.contains("compiling main.cpp"), m_qbsStdout.constData());
+    QVERIFY2(!m_qbsStdout.contains("compiling numbers.cppm"), m_qbsStdout.constData());
+}
+
 void TestBlackbox::conanfileProbe()
 {
     QString executable = findExecutable({"conan"});
@@ -2429,6 +2461,19 @@ void TestBlackbox::recursiveWildcards()
     QVERIFY(!QFileInfo(defaultInstallRoot + "/dir/file3.txt").exists());
     QVERIFY2(outputFile.open(QIODevice::ReadOnly), qPrintable(outputFile.errorString()));
     QCOMPARE(outputFile.readAll(), QByteArray("file1.txtfile2.txt"));
+    outputFile.close();
+
+    // A new file in a directory that did not contain any matches before must be found as well.
+    QVERIFY(QDir().mkpath("dir/emptysubdir"));
+    QCOMPARE(runQbs(QbsRunParameters("install")), 0);
+    WAIT_FOR_NEW_TIMESTAMP();
+    QFile newFile2("dir/emptysubdir/file4.txt");
+    QVERIFY2(newFile2.open(QIODevice::WriteOnly), qPrintable(newFile2.errorString()));
+    newFile2.close();
+    QCOMPARE(runQbs(QbsRunParameters("install")), 0);
+    QVERIFY(QFileInfo(defaultInstallRoot + "/dir/file4.txt").exists());
+    QVERIFY2(outputFile.open(QIODevice::ReadOnly), qPrintable(outputFile.errorString()));
+    QCOMPARE(outputFile.readAll(), QByteArray("file1.txtfile2.txtfile4.txt"));
 }
 
 void TestBlackbox::referenceErrorInExport()
@@ -5169,6 +5214,55 @@ void TestBlackbox::requireDeprecated()
              m_qbsStderr.constData());
 }
 
+void TestBlackbox::rescuePrepareScriptResults()
+{
+    QDir::setCurrent(testDataDir + "/rescue-prepare-script-results");
+    QCOMPARE(runQbs(), 0);
+    QVERIFY2(m_qbsStdout.contains("running prepare script for input1.in"),
+             m_qbsStdout.constData());
+    QVERIFY2(m_qbsStdout.contains("running prepare script for input2.in"),
+             m_qbsStdout.constData());
+    QVERIFY2(m_qbsStdout.contains("creating input1.out"), m_qbsStdout.constData());
+    QVERIFY2(m_qbsStdout.contains("creating input2.out"), m_qbsStdout.constData());
+
+    // The product changes, but not in a way that is relevant to the prepare script.
+    QCOMPARE(runQbs(QbsRunParameters("resolve", QStringList("products.p.unusedProp:y"))), 0);
+    QCOMPARE(runQbs(), 0);
+    QVERIFY2(!m_qbsStdout.contains("running prepare script"), m_qbsStdout.constData());
+    QVERIFY2(!m_qbsStdout.contains("creating"), m_qbsStdout.constData());
+
+    // A property read by the prepare script changes.
+    QCOMPARE(runQbs(QbsRunParameters("resolve", QStringList("products.p.usedProp:b"))), 0);
+    QCOMPARE(runQbs(), 0);
+    QVERIFY2(m_qbsStdout.contains("running prepare script for input1.in"),
+             m_qbsStdout.constData());
+    QVERIFY2(m_qbsStdout.contains("running prepare script for input2.in"),
+             m_qbsStdout.constData());
+    QVERIFY2(m_qbsStdout.contains("creating input1.out"), m_qbsStdout.constData());
+    QVERIFY2(m_qbsStdout.contains("creating input2.out"), m_qbsStdout.constData());
+
+    // The file tags of one input change.
+    QCOMPARE(runQbs(QbsRunParameters("resolve", QStringList("products.p.extraTags:extra"))), 0);
+    QCOMPARE(runQbs(), 0);
+    QVERIFY2(!m_qbsStdout.contains("running prepare script for input1.in"),
+             m_qbsStdout.constData());
+    QVERIFY2(m_qbsStdout.contains("running prepare script for input2.in"),
+             m_qbsStdout.constData());
+    QVERIFY2(!m_qbsStdout.contains("creating input1.out"), m_qbsStdout.constData());
+    QVERIFY2(m_qbsStdout.contains("creating input2.out"), m_qbsStdout.constData());
+
+    // The prepare script itself changes, but reads the same properties as before.
+    WAIT_FOR_NEW_TIMESTAMP();
+    REPLACE_IN_FILE("rescue-prepare-script-results.qbs", "\"creating \"", "\"generating \"");
+    QCOMPARE(runQbs(), 0);
+    QVERIFY2(m_qbsStdout.contains("running prepare script for input1.in"),
+             m_qbsStdout.constData());
+    QVERIFY2(m_qbsStdout.contains("running prepare script for input2.in"),
+             m_qbsStdout.constData());
+    QVERIFY2(m_qbsStdout.contains("generating input1.out"), m_qbsStdout.constData());
+    QVERIFY2(m_qbsStdout.contains("generating input2.out"), m_qbsStdout.constData());
+}
+
 void TestBlackbox::rescueTransformerData()
 {
     QDir::setCurrent(testDataDir + "/rescue-transformer-data");
@@ -5237,6 +5331,96 @@ void TestBlackbox::multiplexedTool()
     QCOMPARE(m_qbsStdout.count("creating tool.out"), 4);
 }
 
+void TestBlackbox::nativeCompilerFlags_data()
+{
+    QTest::addColumn<QStringList>("properties");
+    QTest::addColumn<int>("expectedCommandCount");
+    QTest::newRow("default") << QStringList() << 4;
+    QTest::newRow("precompiled header") << QStringList("products.app.usePch:true") << 5;
+    QTest::newRow("reproducible builds")
+            << QStringList("modules.cpp.enableReproducibleBuilds:true") << 4;
+    QTest::newRow("Objective-C") << QStringList("products.app.useObjc:true") << 6;
+    QTest::newRow("cpufeatures")
+            << QStringList({"modules.cpufeatures.x86_sse4_1:true",
+                            "modules.cpufeatures.x86_avx:false",
+                            "modules.cpufeatures.arm_neon:true"}) << 4;
+    QTest::newRow("C++ modules") << QStringList("products.app.useCxxModules:true") << 5;
+}
+
+void TestBlackbox::nativeCompilerFlags()
+{
+    QFETCH(QStringList, properties);
+    QFETCH(int, expectedCommandCount);
+    QDir::setCurrent(testDataDir + "/native-compiler-flags");
+    rmDirR(relativeBuildDir());
+    QCOMPARE(runQbs(QbsRunParameters("resolve", properties)), 0);
+    if (!m_qbsStdout.contains("is gcc: true")) {
+        QVERIFY2(m_qbsStdout.contains("is gcc: false"), m_qbsStdout.constData());
+        QSKIP("Not GCC or Clang");
+    }
+    const bool isClang = m_qbsStdout.contains("is clang: true");
+    const bool isX86 = m_qbsStdout.contains("architecture: x86");
+    const bool isArm = m_qbsStdout.contains("architecture: arm");
+
+    const auto compilerCommandLines = [this, &properties](bool native) {
+        QbsRunParameters params(QStringList{"-n", "--command-echo-mode", "command-line",
+                QStringLiteral("modules.cpp.useNativeCompilerFlags:")
+                + (native ? "true" : "false")} + properties);
+        if (runQbs(params) != 0)
+            return QByteArrayList();
+        QByteArrayList lines;
+        for (const QByteArray &line : m_qbsStdout.split('\n')) {
+            if (line.contains(" -c "))
+                lines << line.trimmed();
+        }
+        std::sort(lines.begin(), lines.end());
+        return lines;
+    };
+    const QByteArrayList jsCommandLines = compilerCommandLines(false);
+    QCOMPARE(jsCommandLines.size(), expectedCommandCount);
+    QCOMPARE(compilerCommandLines(true), jsCommandLines);
+
+    // Make sure the feature under test actually shows up in the command lines.
+    const QByteArray joinedCommandLines = jsCommandLines.join('\n');
+    const QByteArray dataTag = QTest::currentDataTag();
+    QByteArray expectedFlag;
+    if (dataTag == "precompiled header")
+        expectedFlag = "-include";
+    else if (dataTag == "reproducible builds" && !isClang)
+        expectedFlag = "-frandom-seed=0x";
+    else if (dataTag == "Objective-C")
+        expectedFlag = "objective-c++";
+    else if (dataTag == "cpufeatures" && isX86)
+        expectedFlag = "-mno-avx";
+    else if (dataTag == "cpufeatures" && isArm)
+        expectedFlag = "-mfpu=neon";
+    else if (dataTag == "C++ modules")
+        expectedFlag = isClang ? "-fprebuilt-module-path=" : "-fmodules-ts";
+    if (!expectedFlag.isEmpty())
+        QVERIFY2(joinedCommandLines.contains(expectedFlag), joinedCommandLines.constData());
+    if (!properties.isEmpty())
+        return;
+
+    // The flags shared by several files must still be tracked for each of them.
+    QbsRunParameters params(QStringList("modules.cpp.useNativeCompilerFlags:true"));
+    QCOMPARE(runQbs(params), 0);
+    QVERIFY2(m_qbsStdout.contains("compiling main.cpp"), m_qbsStdout.constData());
+    params.command = "resolve";
+    params.arguments << "products.app.specialDefine:OTHER";
+    QCOMPARE(runQbs(params), 0);
+    QCOMPARE(runQbs(), 0);
+    QVERIFY2(m_qbsStdout.contains("compiling special.cpp"), m_qbsStdout.constData());
+    QVERIFY2(!m_qbsStdout.contains("compiling main.cpp"), m_qbsStdout.constData());
+    QVERIFY2(!m_qbsStdout.contains("compiling other.cpp"), m_qbsStdout.constData());
+    params.arguments = QStringList({"modules.cpp.useNativeCompilerFlags:true",
+                                    "modules.cpp.warningLevel:none"});
+    QCOMPARE(runQbs(params), 0);
+    QCOMPARE(runQbs(), 0);
+    QVERIFY2(m_qbsStdout.contains("compiling main.cpp"), m_qbsStdout.constData());
+    QVERIFY2(m_qbsStdout.contains("compiling other.cpp"), m_qbsStdout.constData());
+    QVERIFY2(m_qbsStdout.contains("compiling util.c"), m_qbsStdout.constData());
+}
+
 void TestBlackbox::nestedGroups()
 {
     QDir::setCurrent(testDataDir + "/nested-groups");
@@ -5264,6 +5448,53 @@ void TestBlackbox::newOutputArtifact()
     QVERIFY(regularFileExists(the100thArtifact));
 }
 
+void TestBlackbox::ninjaGenerator()
+{
+    QDir::setCurrent(testDataDir + "/ninja-generator");
+    const QbsRunParameters params("generate", QStringList{"-g", "ninja"});
+    QCOMPARE(runQbs(params), 0);
+    QVERIFY(regularFileExists(relativeBuildDir() + "/build.ninja"));
+    QVERIFY(!QFile::exists(relativeBuildGraphFilePath()));
+    if (m_qbsStdout.contains("targetPlatform differs from hostPlatform"))
+        QSKIP("Cannot run binaries in cross-compiled build");
+    const QString ninjaFilePath = findExecutable(QStringList("ninja"));
+    if (ninjaFilePath.isEmpty())
+        QSKIP("ninja not found");
+
+    // The JavaScriptCommand creating the header is delegated to qbs, the rest runs in ninja.
+    QProcess ninja;
+    ninja.setWorkingDirectory(QDir::currentPath() + '/' + relativeBuildDir());
+    ninja.start(ninjaFilePath, QStringList());
+    QVERIFY(waitForProcessSuccess(ninja));
+    QVERIFY(regularFileExists(relativeExecutableFilePath("the app")));
+    QProcess app;
+    app.start(QDir::currentPath() + '/' + relativeExecutableFilePath("the app"), QStringList());
+    QVERIFY(waitForProcessSuccess(app));
+    const QByteArray appStdout = app.readAllStandardOutput();
+    QVERIFY2(appStdout.contains("Hello from ninja!"), appStdout.constData());
+
+    ninja.start(ninjaFilePath, QStringList());
+    QVERIFY(waitForProcessSuccess(ninja));
+    const QByteArray ninjaStdout = ninja.readAllStandardOutput();
+    QVERIFY2(ninjaStdout.contains("no work to do"), ninjaStdout.constData());
+
+    // No build has happened yet, so header dependencies must come from the compiler.
+    QFile ninjaFile(relativeBuildDir() + "/build.ninja");
+    QVERIFY2(ninjaFile.open(QIODevice::ReadOnly), qPrintable(ninjaFile.errorString()));
+    if (!ninjaFile.readAll().contains("deps = gcc")) {
+        QVERIFY2(m_qbsStderr.contains("No header dependencies are known"),
+                 m_qbsStderr.constData());
+        QSKIP("Compiler does not support dependency files");
+    }
+    WAIT_FOR_NEW_TIMESTAMP();
+    touch("exitcode.h");
+    ninja.start(ninjaFilePath, QStringList());
+    QVERIFY(waitForProcessSuccess(ninja));
+    const QByteArray rebuildStdout = ninja.readAllStandardOutput();
+    QVERIFY2(rebuildStdout.contains("compiling main.cpp"), rebuildStdout.constData());
+    QVERIFY2(!rebuildStdout.contains("generating greeting.h"), rebuildStdout.constData());
+}
+
 void TestBlackbox::noExportedSymbols_data()
 {
     QTest::addColumn<bool>("link");
@@ -6055,6 +6286,48 @@ static QJsonObject getNextSessionPacket(QProcess &session, QByteArray &data)
     return QJsonDocument::fromJson(QByteArray::fromBase64(msg)).object();
 }
 
+static void sendSessionPacket(QProcess &session, const QJsonObject &message)
+{
+    const QByteArray data = QJsonDocument(message).toJson().toBase64();
+    session.write("qbsmsg:");
+    session.write(QByteArray::number(data.length()));
+    session.write("\n");
+    session.write(data);
+}
+
+// Skips all packets up to the one of the given type. Returns an empty object on timeout.
+static QJsonObject getSessionReply(QProcess &session, QByteArray &data, const QString &replyType,
+                                   QStringList *commandDescriptions = nullptr)
+{
+    while (true) {
+        const QJsonObject message = getNextSessionPacket(session, data);
+        const QString type = message.value("type").toString();
+        if (message.isEmpty() || type == replyType)
+            return message;
+        if (type == "command-description" && commandDescriptions)
+            commandDescriptions->push_back(message.value("message").toString());
+    }
+}
+
+static QJsonObject sessionResolveRequest(const QString &projectFilePath,
+                                         const QString &configurationName)
+{
+    QJsonObject request;
+    request.insert("type", "resolve-project");
+    request.insert("top-level-profile", profileName());
+    request.insert("configuration-name", configurationName);
+    request.insert("project-file-path", projectFilePath);
+    request.insert("build-root", QDir::currentPath());
+    request.insert("settings-directory", settings()->baseDirectory());
+    QJsonObject envObj;
+    const QProcessEnvironment env = QbsRunParameters::defaultEnvironment();
+    const QStringList keys = env.keys();
+    for (const QString &key : keys)
+        envObj.insert(key, env.value(key));
+    request.insert("environment", envObj);
+    return request;
+}
+
 void TestBlackbox::qbsSession()
 {
     QDir::setCurrent(testDataDir + "/qbs-session");
@@ -6700,6 +6973,112 @@ void TestBlackbox::qbsSession()
     QVERIFY(sessionProc.waitForFinished(3000));
 }
 
+void TestBlackbox::qbsSessionWatchFiles()
+{
+    QDir::setCurrent(testDataDir + "/qbs-session-watch-files");
+    QProcess sessionProc;
+    sessionProc.start(qbsExecutableFilePath, QStringList("session"));
+    QVERIFY(sessionProc.waitForStarted());
+    QByteArray incomingData;
+    QCOMPARE(getNextSessionPacket(sessionProc, incomingData).value("type"), "hello");
+
+    QJsonObject resolveRequest = sessionResolveRequest(
+                QDir::currentPath() + "/qbs-session-watch-files.qbs", "watch-files");
+    resolveRequest.insert("watch-files", true);
+    sendSessionPacket(sessionProc, resolveRequest);
+    QJsonObject reply = getSessionReply(sessionProc, incomingData, "project-resolved");
+    QVERIFY(!reply.isEmpty());
+    QVERIFY2(!reply.contains("error"), qPrintable(QJsonDocument(reply).toJson()));
+
+    const auto build = [&] {
+        QJsonObject buildRequest;
+        buildRequest.insert("type", "build-project");
+        sendSessionPacket(sessionProc, buildRequest);
+        QStringList descriptions;
+        reply = getSessionReply(sessionProc, incomingData, "project-built", &descriptions);
+        return descriptions.join('\n');
+    };
+
+    // Initial build. The journal becomes valid afterwards.
+    QString descriptions = build();
+    QVERIFY2(!reply.isEmpty() && !reply.contains("error"), qPrintable(descriptions));
+    QVERIFY2(descriptions.contains("processing a.txt"), qPrintable(descriptions));
+    QVERIFY2(descriptions.contains("processing b.txt"), qPrintable(descriptions));
+
+    descriptions = build();
+    QVERIFY2(!reply.isEmpty() && !reply.contains("error"), qPrintable(descriptions));
+    QVERIFY2(!descriptions.contains("processing"), qPrintable(descriptions));
+
+    // The build trusts the journal, so the edit is only seen if the watcher reported it.
+    WAIT_FOR_NEW_TIMESTAMP();
+    REPLACE_IN_FILE("a.txt", "a", "a2");
+    QTest::qSleep(1000); // Give the session time to receive the change notification.
+    descriptions = build();
+    QVERIFY2(!reply.isEmpty() && !reply.contains("error"), qPrintable(descriptions));
+    QVERIFY2(descriptions.contains("processing a.txt"), qPrintable(descriptions));
+    QVERIFY2(!descriptions.contains("processing b.txt"), qPrintable(descriptions));
+
+    QJsonObject quitRequest;
+    quitRequest.insert("type", "quit");
+    sendSessionPacket(sessionProc, quitRequest);
+    QVERIFY(sessionProc.waitForFinished());
+}
+
+void TestBlackbox::qbsSessionWatchFilesPartialBuild()
+{
+    QDir::setCurrent(testDataDir + "/qbs-session-watch-files");
+    QProcess sessionProc;
+    sessionProc.start(qbsExecutableFilePath, QStringList("session"));
+    QVERIFY(sessionProc.waitForStarted());
+    QByteArray incomingData;
+    QCOMPARE(getNextSessionPacket(sessionProc, incomingData).value("type"), "hello");
+
+    QJsonObject resolveRequest = sessionResolveRequest(
+                QDir::currentPath() + "/qbs-session-watch-files.qbs", "partial-build");
+    resolveRequest.insert("watch-files", true);
+    sendSessionPacket(sessionProc, resolveRequest);
+    QJsonObject reply = getSessionReply(sessionProc, incomingData, "project-resolved");
+    QVERIFY(!reply.isEmpty());
+    QVERIFY2(!reply.contains("error"), qPrintable(QJsonDocument(reply).toJson()));
+
+    const auto build = [&](const QStringList &products) {
+        QJsonObject buildRequest;
+        buildRequest.insert("type", "build-project");
+        if (!products.isEmpty())
+            buildRequest.insert("products", QJsonArray::fromStringList(products));
+        sendSessionPacket(sessionProc, buildRequest);
+        QStringList descriptions;
+        reply = getSessionReply(sessionProc, incomingData, "project-built", &descriptions);
+        return descriptions.join('\n');
+    };
+
+    QString descriptions = build({});
+    QVERIFY2(!reply.isEmpty() && !reply.contains("error"), qPrintable(descriptions));
+    QVERIFY2(descriptions.contains("processing a.txt"), qPrintable(descriptions));
+    QVERIFY2(descriptions.contains("processing b.txt"), qPrintable(descriptions));
+
+    WAIT_FOR_NEW_TIMESTAMP();
+    REPLACE_IN_FILE("a.txt", "\n", "x\n");
+    REPLACE_IN_FILE("b.txt", "\n", "x\n");
+    QTest::qSleep(1000); // Give the session time to receive the change notifications.
+
+    // Building only one product must not make the session forget about the other change.
+    descriptions = build({"a"});
+    QVERIFY2(!reply.isEmpty() && !reply.contains("error"), qPrintable(descriptions));
+    QVERIFY2(descriptions.contains("processing a.txt"), qPrintable(descriptions));
+    QVERIFY2(!descriptions.contains("processing b.txt"), qPrintable(descriptions));
+
+    descriptions = build({});
+    QVERIFY2(!reply.isEmpty() && !reply.contains("error"), qPrintable(descriptions));
+    QVERIFY2(!descriptions.contains("processing a.txt"), qPrintable(descriptions));
+    QVERIFY2(descriptions.contains("processing b.txt"), qPrintable(descriptions));
+
+    QJsonObject quitRequest;
+    quitRequest.insert("type", "quit");
+    sendSessionPacket(sessionProc, quitRequest);
+    QVERIFY(sessionProc.waitForFinished());
+}
+
 void TestBlackbox::radAfterIncompleteBuild_data()
 {
     QTest::addColumn<QString>("projectFileName");
@@ -7023,6 +7402,32 @@ void TestBlackbox::assembly()
     QCOMPARE(m_qbsStdout.contains("creating testd.lib"), haveMSVC);
 }
 
+void TestBlackbox::automaticPrecompiledHeader()
+{
+    QDir::setCurrent(testDataDir + "/automatic-precompiled-header");
+    QCOMPARE(runQbs(), 0);
+    QVERIFY2(m_qbsStdout.contains("precompiling theapp_autopch.h"), m_qbsStdout.constData());
+    QVERIFY2(m_qbsStdout.contains("compiling file1.cpp"), m_qbsStdout.constData());
+
+    WAIT_FOR_NEW_TIMESTAMP();
+    touch("file2.cpp");
+    QCOMPARE(runQbs(), 0);
+    QVERIFY2(m_qbsStdout.contains("compiling file2.cpp"), m_qbsStdout.constData());
+    QVERIFY2(!m_qbsStdout.contains("precompiling theapp_autopch.h"), m_qbsStdout.constData());
+
+    // A header used by too few sources does not change the generated header.
+    WAIT_FOR_NEW_TIMESTAMP();
+    REPLACE_IN_FILE("file2.cpp", "#include <vector>", "#include <vector>\n#include <map>");
+    QCOMPARE(runQbs(), 0);
+    QVERIFY2(m_qbsStdout.contains("compiling file2.cpp"), m_qbsStdout.constData());
+    QVERIFY2(!m_qbsStdout.contains("precompiling theapp_autopch.h"), m_qbsStdout.constData());
+
+    WAIT_FOR_NEW_TIMESTAMP();
+    REPLACE_IN_FILE("file1.cpp", "#include <vector>", "#include <vector>\n#include <map>");
+    QCOMPARE(runQbs(), 0);
+    QVERIFY2(m_qbsStdout.contains("precompiling theapp_autopch.h"), m_qbsStdout.constData());
+}
+
 void TestBlackbox::autotestWithDependencies()
 {
     QDir::setCurrent(testDataDir + "/autotest-with-dependencies");
@@ -7034,6 +7439,72 @@ void TestBlackbox::autotestWithDependencies()
              && m_qbsStdout.contains("i am the helper"), m_qbsStdout.constData());
 }
 
+void TestBlackbox::autotestResultCache()
+{
+    QDir::setCurrent(testDataDir + "/autotest-result-cache");
+    QCOMPARE(runQbs({"resolve"}), 0);
+    if (m_qbsStdout.contains("targetPlatform differs from hostPlatform"))
+        QSKIP("Cannot run binaries in cross-compiled build");
+    const QbsRunParameters params(QStringList({"-p", "autotest-runner"}));
+    QCOMPARE(runQbs(params), 0);
+    QVERIFY2(m_qbsStdout.contains("i am the test app"), m_qbsStdout.constData());
+    QVERIFY2(!m_qbsStdout.contains("passed (cached)"), m_qbsStdout.constData());
+
+    // Nothing has changed, so the test is not run again.
+    QCOMPARE(runQbs(params), 0);
+    QVERIFY2(!m_qbsStdout.contains("i am the test app"), m_qbsStdout.constData());
+
+    // A property change that does not affect the test result reports the cached result.
+    QCOMPARE(runQbs(QbsRunParameters("resolve", {"products.autotest-runner.timeout:1000"})), 0);
+    QCOMPARE(runQbs(params), 0);
+    QVERIFY2(!m_qbsStdout.contains("i am the test app"), m_qbsStdout.constData());
+    QVERIFY2(m_qbsStdout.contains("passed (cached)"), m_qbsStdout.constData());
+
+    // A changed library invalidates the cached result.
+    WAIT_FOR_NEW_TIMESTAMP();
+    REPLACE_IN_FILE("lib.cpp", "return 1;", "return 2;");
+    QCOMPARE(runQbs(params), 0);
+    QVERIFY2(m_qbsStdout.contains("i am the test app"), m_qbsStdout.constData());
+    QCOMPARE(runQbs(params), 0);
+    QVERIFY2(!m_qbsStdout.contains("i am the test app"), m_qbsStdout.constData());
+
+    // So does a changed auxiliary input, but not one that was merely touched.
+    WAIT_FOR_NEW_TIMESTAMP();
+    REPLACE_IN_FILE("test-data.txt", "first version", "second version");
+    QCOMPARE(runQbs(params), 0);
+    QVERIFY2(m_qbsStdout.contains("i am the test app"), m_qbsStdout.constData());
+    WAIT_FOR_NEW_TIMESTAMP();
+    touch("test-data.txt");
+    QCOMPARE(runQbs(params), 0);
+    QVERIFY2(!m_qbsStdout.contains("i am the test app"), m_qbsStdout.constData());
+    QVERIFY2(m_qbsStdout.contains("passed (cached)"), m_qbsStdout.constData());
+
+    // So do changed arguments.
+    QCOMPARE(runQbs(QbsRunParameters("resolve", {"products.autotest-runner.timeout:1000",
+                                                  "products.autotest-runner.arguments:-v"})), 0);
+    QCOMPARE(runQbs(params), 0);
+    QVERIFY2(m_qbsStdout.contains("i am the test app"), m_qbsStdout.constData());
+}
+
+void TestBlackbox::autotestSharding()
+{
+    QDir::setCurrent(testDataDir + "/autotest-sharding");
+    QCOMPARE(runQbs({"resolve"}), 0);
+    if (m_qbsStdout.contains("targetPlatform differs from hostPlatform"))
+        QSKIP("Cannot run binaries in cross-compiled build");
+    QCOMPARE(runQbs(QStringList({"-p", "autotest-runner"})), 0);
+    QVERIFY2(m_qbsStdout.contains("running shard 0 of 3")
+             && m_qbsStdout.contains("running shard 1 of 3")
+             && m_qbsStdout.contains("running shard 2 of 3"), m_qbsStdout.constData());
+    QVERIFY2(m_qbsStdout.contains("(shard 3/3)"), m_qbsStdout.constData());
+
+    // A different shard count changes the number of jobs.
+    QCOMPARE(runQbs(QbsRunParameters("resolve", {"products.test-app.autotest.shardCount:1"})), 0);
+    QCOMPARE(runQbs(QStringList({"-p", "autotest-runner"})), 0);
+    QVERIFY2(!m_qbsStdout.contains("running shard"), m_qbsStdout.constData());
+    QVERIFY2(m_qbsStdout.contains("running all shards"), m_qbsStdout.constData());
+}
+
 void TestBlackbox::autotestTimeout()
 {
     QFETCH(QStringList, resolveParams);
@@ -7502,6 +7973,30 @@ void TestBlackbox::undefinedTargetPlatform()
     QCOMPARE(runQbs(), 0);
 }
 
+void TestBlackbox::unityBuild()
+{
+    QDir::setCurrent(testDataDir + "/unity-build");
+    QCOMPARE(runQbs(), 0);
+    QCOMPARE(m_qbsStdout.count("compiling unity_theapp_"), 1);
+    QVERIFY2(m_qbsStdout.contains("compiling separate.cpp"), m_qbsStdout.constData());
+    QVERIFY2(m_qbsStdout.contains("compiling uncombinable.cpp"), m_qbsStdout.constData());
+    QVERIFY2(!m_qbsStdout.contains("compiling main.cpp"), m_qbsStdout.constData());
+    QVERIFY2(!m_qbsStdout.contains("compiling file1.cpp"), m_qbsStdout.constData());
+
+    WAIT_FOR_NEW_TIMESTAMP();
+    touch("file1.cpp");
+    QCOMPARE(runQbs(), 0);
+    QCOMPARE(m_qbsStdout.count("compiling unity_theapp_"), 1);
+    QVERIFY2(!m_qbsStdout.contains("compiling separate.cpp"), m_qbsStdout.constData());
+    QVERIFY2(!m_qbsStdout.contains("compiling uncombinable.cpp"), m_qbsStdout.constData());
+
+    WAIT_FOR_NEW_TIMESTAMP();
+    touch("separate.cpp");
+    QCOMPARE(runQbs(), 0);
+    QVERIFY2(m_qbsStdout.contains("compiling separate.cpp"), m_qbsStdout.constData());
+    QVERIFY2(!m_qbsStdout.contains("compiling unity_theapp_"), m_qbsStdout.constData());
+}
+
 void TestBlackbox::importInPropertiesCondition()
 {
     QDir::setCurrent(testDataDir + "/import-in-properties-condition");
@@ -7659,6 +8154,46 @@ void TestBlackbox::localDeployment()
     QVERIFY2(m_qbsStdout.contains(content), m_qbsStdout.constData());
 }
 
+void TestBlackbox::longestJobsFirst()
+{
+    QDir::setCurrent(testDataDir + "/longest-jobs-first");
+    const QbsRunParameters params(QStringList{"-j", "1"});
+
+    // The first build records how long each job takes.
+    QCOMPARE(runQbs(params), 0);
+    QCOMPARE(m_qbsStdout.count("processing "), 3);
+
+    // In the next build, the job that took longest is started first.
+    WAIT_FOR_NEW_TIMESTAMP();
+    touch("a-short.txt");
+    touch("b-long.txt");
+    touch("c-short.txt");
+    QCOMPARE(runQbs(params), 0);
+    QCOMPARE(m_qbsStdout.count("processing "), 3);
+    const int longIndex = m_qbsStdout.indexOf("processing b-long.txt");
+    QVERIFY2(longIndex != -1, m_qbsStdout.constData());
+    QVERIFY2(longIndex < m_qbsStdout.indexOf("processing a-short.txt"), m_qbsStdout.constData());
+    QVERIFY2(longIndex < m_qbsStdout.indexOf("processing c-short.txt"), m_qbsStdout.constData());
+
+    // The durations follow changes in the project.
+    WAIT_FOR_NEW_TIMESTAMP();
+    REPLACE_IN_FILE("b-long.txt", "1500", "0");
+    REPLACE_IN_FILE("c-short.txt", "200", "1500");
+    QCOMPARE(runQbs(params), 0);
+    WAIT_FOR_NEW_TIMESTAMP();
+    touch("a-short.txt");
+    touch("b-long.txt");
+    touch("c-short.txt");
+    QCOMPARE(runQbs(params), 0);
+    QCOMPARE(m_qbsStdout.count("processing "), 3);
+    const int newLongIndex = m_qbsStdout.indexOf("processing c-short.txt");
+    QVERIFY2(newLongIndex != -1, m_qbsStdout.constData());
+    QVERIFY2(newLongIndex < m_qbsStdout.indexOf("processing a-short.txt"),
+             m_qbsStdout.constData());
+    QVERIFY2(newLongIndex < m_qbsStdout.indexOf("processing b-long.txt"),
+             m_qbsStdout.constData());
+}
+
 void TestBlackbox::makefileGenerator()
 {
     QDir::setCurrent(testDataDir + "/makefile-generator");
@@ -7767,6 +8302,33 @@ void TestBlackbox::moduleProviders()
     QVERIFY2(m_qbsStdout.contains("The letters are Z and Y"), m_qbsStdout.constData());
 }
 
+void TestBlackbox::moduleProviderCache()
+{
+    QDir::setCurrent(testDataDir + "/cached-module-provider");
+    const QString keyProperty = "moduleProviders.cachedgen.key:";
+    const QString key = QString::number(QDateTime::currentMSecsSinceEpoch());
+
+    // The first run fills the cache.
+    QbsRunParameters params("resolve", QStringList(keyProperty + key));
+    params.buildDirectory = "build1";
+    QCOMPARE(runQbs(params), 0);
+    QCOMPARE(m_qbsStdout.count("Running setup script for cachedgen"), 1);
+    QVERIFY2(m_qbsStdout.contains("The greeting is hello"), m_qbsStdout.constData());
+
+    // A different build directory with the same cache key gets the modules from the cache.
+    params.buildDirectory = "build2";
+    QCOMPARE(runQbs(params), 0);
+    QVERIFY2(!m_qbsStdout.contains("Running setup script"), m_qbsStdout.constData());
+    QVERIFY2(m_qbsStdout.contains("The greeting is hello"), m_qbsStdout.constData());
+
+    // A new key means the provider has to run again.
+    params.arguments = QStringList(keyProperty + key + "-other");
+    params.buildDirectory = "build3";
+    QCOMPARE(runQbs(params), 0);
+    QCOMPARE(m_qbsStdout.count("Running setup script for cachedgen"), 1);
+    QVERIFY2(m_qbsStdout.contains("The greeting is hello"), m_qbsStdout.constData());
+}
+
 void TestBlackbox::fallbackModuleProvider_data()
 {
     QTest::addColumn<bool>("fallbacksEnabledGlobally");
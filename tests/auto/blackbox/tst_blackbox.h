@@ -50,7 +50,10 @@ private slots:
     void artifactsMapRaceCondition();
     void artifactScanning();
     void assembly();
+    void automaticPrecompiledHeader();
     void autotestWithDependencies();
+    void autotestResultCache();
+    void autotestSharding();
     void autotestTimeout();
     void autotestTimeout_data();
     void autotests_data();
@@ -89,6 +92,7 @@ private slots:
     void conflictingArtifacts();
     void cxxLanguageVersion();
     void cxxLanguageVersion_data();
+    void cxxModules();
     void conanfileProbe();
     void cpuFeatures();
     void dependenciesProperty();
@@ -189,10 +193,12 @@ private slots:
     void listPropertyOrder();
     void loadableModule();
     void localDeployment();
+    void longestJobsFirst();
     void makefileGenerator();
     void maximumCLanguageVersion();
     void maximumCxxLanguageVersion();
     void moduleProviders();
+    void moduleProviderCache();
     void fallbackModuleProvider_data();
     void fallbackModuleProvider();
     void minimumSystemVersion();
@@ -207,9 +213,12 @@ private slots:
     void multipleChanges();
     void multipleConfigurations();
     void multiplexedTool();
+    void nativeCompilerFlags_data();
+    void nativeCompilerFlags();
     void nestedGroups();
     void nestedProperties();
     void newOutputArtifact();
+    void ninjaGenerator();
     void noExportedSymbols_data();
     void noExportedSymbols();
     void noProfile();
@@ -259,6 +268,8 @@ private slots:
     void qbsConfigAddProfile();
     void qbsConfigAddProfile_data();
     void qbsSession();
+    void qbsSessionWatchFiles();
+    void qbsSessionWatchFilesPartialBuild();
     void qbsVersion();
     void qtBug51237();
     void radAfterIncompleteBuild();
@@ -272,6 +283,7 @@ private slots:
     void reproducibleBuild_data();
     void require();
     void requireDeprecated();
+    void rescuePrepareScriptResults();
     void rescueTransformerData();
     void responseFiles();
     void retaggedOutputArtifact();
@@ -323,6 +335,7 @@ private slots:
     void transitiveOptionalDependencies();
     void typescript();
     void undefinedTargetPlatform();
+    void unityBuild();
     void usingsAsSoleInputsNonMultiplexed();
     void variantSuffix();
     void variantSuffix_data();
@@ -42,6 +42,11 @@ private slots:
     void initTestCase();
     void jobLimits_data();
     void jobLimits();
+    void jobTokensAreShared_data();
+    void jobTokensAreShared();
+    void makeJobServer();
+    void adaptiveJobScheduling();
+    void adaptiveJobSchedulingHoldsBackJobs();
 };
 
 TestBlackboxJobLimits::TestBlackboxJobLimits()
@@ -181,6 +186,123 @@ void TestBlackboxJobLimits::jobLimits()
         QCOMPARE(m_qbsStdout.count("Running tool"), 5);
 }
 
+void TestBlackboxJobLimits::jobTokensAreShared_data()
+{
+    QTest::addColumn<bool>("provideMakeJobServer");
+    QTest::newRow("in-process tokens") << false;
+    QTest::newRow("make job server") << true;
+}
+
+void TestBlackboxJobLimits::jobTokensAreShared()
+{
+    if (qbs::Internal::HostOsInfo::isWindowsHost())
+        QSKIP("test uses a POSIX shell");
+    QDir::setCurrent(testDataDir + "/job-server");
+    QFETCH(bool, provideMakeJobServer);
+
+    // Two configurations built by one qbs process must not run more than one job in total.
+    const QString profileArg = QLatin1String("profile:") + profileName();
+    const QString configPrefix = provideMakeJobServer ? "config:make-" : "config:";
+    QbsRunParameters params(QStringList{"-j", "1", configPrefix + "one", profileArg,
+                                        configPrefix + "two", profileArg});
+    params.profile.clear();
+    if (provideMakeJobServer)
+        params.arguments << "--make-jobserver";
+    QCOMPARE(runQbs(params), 0);
+    QCOMPARE(m_qbsStdout.count("processing a.txt"), 2);
+    QCOMPARE(m_qbsStdout.count("processing b.txt"), 2);
+    QVERIFY2(!m_qbsStderr.contains("jobs overlap"), m_qbsStderr.constData());
+    QCOMPARE(m_qbsStdout.contains("--jobserver-auth=fifo:"), provideMakeJobServer);
+}
+
+void TestBlackboxJobLimits::makeJobServer()
+{
+    if (qbs::Internal::HostOsInfo::isWindowsHost())
+        QSKIP("the make job server is only supported on Unix hosts");
+    QDir::setCurrent(testDataDir + "/job-server");
+    QbsRunParameters params(QStringList{"-j", "3", "--make-jobserver",
+                                        "products.job-server.exclusive:false"});
+    QCOMPARE(runQbs(params), 0);
+    QCOMPARE(m_qbsStdout.count("processing a.txt"), 1);
+    QCOMPARE(m_qbsStdout.count("processing b.txt"), 1);
+    QCOMPARE(m_qbsStdout.count("MAKEFLAGS=-j3 --jobserver-auth=fifo:"), 2);
+
+    // The fifo is gone after the build.
+    const int pathStart = m_qbsStdout.indexOf("fifo:") + 5;
+    const QByteArray fifoPath = m_qbsStdout.mid(pathStart,
+                                                m_qbsStdout.indexOf('\n', pathStart) - pathStart);
+    QVERIFY2(!fifoPath.isEmpty(), m_qbsStdout.constData());
+    QVERIFY2(!QFileInfo::exists(QString::fromLocal8Bit(fifoPath)), fifoPath.constData());
+
+    // Without the option, nothing is exported.
+    QCOMPARE(runQbs(QbsRunParameters("clean")), 0);
+    QCOMPARE(runQbs(QbsRunParameters(QStringList{"-j", "3",
+                                                 "products.job-server.exclusive:false"})), 0);
+    QCOMPARE(m_qbsStdout.count("processing a.txt"), 1);
+    QVERIFY2(!m_qbsStdout.contains("fifo:" + fifoPath), m_qbsStdout.constData());
+}
+
+void TestBlackboxJobLimits::adaptiveJobScheduling()
+{
+    if (!qbs::Internal::HostOsInfo::isLinuxHost())
+        QSKIP("memory usage is only sampled on Linux");
+    QDir::setCurrent(testDataDir + "/job-server");
+    QbsRunParameters params(QStringList{"-j", "2", "--adaptive-job-scheduling",
+                                        "products.job-server.exclusive:false",
+                                        "config:adaptive"});
+    params.environment.insert("QT_LOGGING_RULES", "qbs.exec.debug=true");
+
+    // The first build records the memory usage of the job pool ...
+    QCOMPARE(runQbs(params), 0);
+    QCOMPARE(m_qbsStdout.count("processing a.txt"), 1);
+    QCOMPARE(m_qbsStdout.count("processing b.txt"), 1);
+    QCOMPARE(m_qbsStderr.count("expected memory usage of job pool \"shell\""), 2);
+
+    // ... which is stored in the build graph and taken into account by the next one.
+    WAIT_FOR_NEW_TIMESTAMP();
+    touch("a.txt");
+    touch("b.txt");
+    QCOMPARE(runQbs(params), 0);
+    QCOMPARE(m_qbsStdout.count("processing a.txt"), 1);
+    QCOMPARE(m_qbsStdout.count("processing b.txt"), 1);
+    QCOMPARE(m_qbsStderr.count("expected memory usage of job pool \"shell\""), 2);
+
+    // Without the option, no memory usage is sampled.
+    WAIT_FOR_NEW_TIMESTAMP();
+    touch("a.txt");
+    params.arguments.removeOne("--adaptive-job-scheduling");
+    QCOMPARE(runQbs(params), 0);
+    QCOMPARE(m_qbsStdout.count("processing a.txt"), 1);
+    QVERIFY2(!m_qbsStderr.contains("expected memory usage"), m_qbsStderr.constData());
+}
+
+void TestBlackboxJobLimits::adaptiveJobSchedulingHoldsBackJobs()
+{
+    if (!qbs::Internal::HostOsInfo::isLinuxHost())
+        QSKIP("memory usage is only sampled on Linux");
+    QDir::setCurrent(testDataDir + "/adaptive-job-scheduling");
+    QbsRunParameters params(QStringList{"-j", "2", "--adaptive-job-scheduling"});
+    params.environment.insert("QT_LOGGING_RULES", "qbs.exec.debug=true");
+
+    // Nothing is known about the jobs yet, so they can run in parallel.
+    QCOMPARE(runQbs(params), 0);
+    QCOMPARE(m_qbsStdout.count("processing a.txt"), 1);
+    QCOMPARE(m_qbsStdout.count("processing b.txt"), 1);
+    QVERIFY2(m_qbsStderr.contains("expected memory usage of job pool \"memory\""),
+             m_qbsStderr.constData());
+
+    // With too little memory for two of them, the second job has to wait for the first one.
+    params.arguments << "products.adaptive-job-scheduling.checkOverlap:true";
+    params.environment.insert("QBS_AUTOTEST_AVAILABLE_MEMORY",
+                              QString::number(qint64(1024) * 1024 * 1024));
+    QCOMPARE(runQbs(params), 0);
+    QCOMPARE(m_qbsStdout.count("processing a.txt"), 1);
+    QCOMPARE(m_qbsStdout.count("processing b.txt"), 1);
+    QVERIFY2(!m_qbsStderr.contains("jobs overlap"), m_qbsStderr.constData());
+    QVERIFY2(m_qbsStderr.contains("node delayed due to low system resources"),
+             m_qbsStderr.constData());
+}
+
 QTEST_MAIN(TestBlackboxJobLimits)
 
 #include <tst_blackboxjoblimits.moc>
@@ -42,15 +42,23 @@
 #include <buildgraph/artifact.h>
 #include <buildgraph/buildgraph.h>
 #include <buildgraph/cycledetector.h>
+#include <buildgraph/depscanner.h>
 #include <buildgraph/productbuilddata.h>
 #include <buildgraph/projectbuilddata.h>
 #include <language/language.h>
+#include <language/propertymapinternal.h>
 #include <logging/logger.h>
+#include <plugins/scanner/scanner.h>
 #include <tools/error.h>
+#include <tools/fileinfo.h>
+
+#include <QtCore/qthread.h>
 
 #include <QtTest/qtest.h>
 
+#include <atomic>
 #include <memory>
+#include <vector>
 
 using namespace qbs;
 using namespace qbs::Internal;
@@ -144,6 +152,174 @@ void TestBuildGraph::testCycle()
     QVERIFY(!cycleDetected(productWithNoCycle()));
 }
 
+namespace {
+
+// A scanner plugin that reports "<base name>.h" as the only dependency of a file,
+// and fails to open files whose name starts with "missing".
+struct FakeScannerStats
+{
+    std::atomic_int openCount{0};
+    std::atomic_int batchCount{0};
+    std::atomic_int activeCalls{0};
+    std::atomic_int maxActiveCalls{0};
+} fakeScannerStats;
+
+class ActiveScannerCall
+{
+public:
+    ActiveScannerCall()
+    {
+        const int activeCalls = ++fakeScannerStats.activeCalls;
+        int maxActiveCalls = fakeScannerStats.maxActiveCalls;
+        while (activeCalls > maxActiveCalls
+               && !fakeScannerStats.maxActiveCalls.compare_exchange_weak(maxActiveCalls,
+                                                                         activeCalls)) {
+        }
+        QThread::msleep(2); // Give other threads the chance to overlap with us.
+    }
+    ~ActiveScannerCall() { --fakeScannerStats.activeCalls; }
+};
+
+QByteArray fakeDependency(const unsigned short *filePath)
+{
+    const QString fileName = FileInfo::fileName(
+                QString::fromUtf16(reinterpret_cast<const char16_t *>(filePath)));
+    if (fileName.startsWith(QLatin1String("missing")))
+        return {};
+    return FileInfo::completeBaseName(fileName).toLocal8Bit() + ".h";
+}
+
+struct FakeScanHandle
+{
+    QByteArray dependency;
+    bool done = false;
+};
+
+void *fakeOpen(const unsigned short *filePath, const char *, int)
+{
+    const ActiveScannerCall call;
+    ++fakeScannerStats.openCount;
+    const QByteArray dependency = fakeDependency(filePath);
+    return dependency.isEmpty() ? nullptr : new FakeScanHandle{dependency};
+}
+
+void fakeClose(void *opaq)
+{
+    delete static_cast<FakeScanHandle *>(opaq);
+}
+
+const char *fakeNext(void *opaq, int *size, int *flags)
+{
+    const auto handle = static_cast<FakeScanHandle *>(opaq);
+    if (handle->done)
+        return nullptr;
+    handle->done = true;
+    *size = handle->dependency.size();
+    *flags = SC_GLOBAL_INCLUDE_FLAG;
+    return handle->dependency.constData();
+}
+
+struct FakeBatch
+{
+    QByteArray arena;
+    std::vector<ScannedDependency> dependencies;
+    std::vector<int> fileOffsets;
+    std::vector<int> fileErrors;
+};
+
+void *fakeScanBatch(const unsigned short * const *filePaths, int fileCount, const char *, int,
+                    ScanBatchResult *result)
+{
+    const ActiveScannerCall call;
+    ++fakeScannerStats.batchCount;
+    const auto batch = new FakeBatch;
+    for (int i = 0; i < fileCount; ++i) {
+        batch->fileOffsets.push_back(int(batch->dependencies.size()));
+        const QByteArray dependency = fakeDependency(filePaths[i]);
+        batch->fileErrors.push_back(dependency.isEmpty() ? 1 : 0);
+        if (dependency.isEmpty())
+            continue;
+        batch->dependencies.push_back({batch->arena.size(), dependency.size(),
+                                       SC_GLOBAL_INCLUDE_FLAG});
+        batch->arena += dependency;
+    }
+    batch->fileOffsets.push_back(int(batch->dependencies.size()));
+    result->arena = batch->arena.constData();
+    result->dependencies = batch->dependencies.data();
+    result->fileOffsets = batch->fileOffsets.data();
+    result->fileErrors = batch->fileErrors.data();
+    return batch;
+}
+
+void fakeReleaseBatch(void *batch)
+{
+    delete static_cast<FakeBatch *>(batch);
+}
+
+} // namespace
+
+void TestBuildGraph::testPluginScanner_data()
+{
+    QTest::addColumn<int>("pluginFlags");
+    QTest::newRow("plugin without new features") << int(NoScannerFlags);
+    QTest::newRow("thread-safe plugin") << int(ScannerIsThreadSafe);
+    QTest::newRow("batch scanning") << int(ScannerSupportsBatchScanning);
+    QTest::newRow("thread-safe batch scanning")
+            << int(ScannerIsThreadSafe | ScannerSupportsBatchScanning);
+}
+
+void TestBuildGraph::testPluginScanner()
+{
+    QFETCH(int, pluginFlags);
+    const bool batchScanning = pluginFlags & ScannerSupportsBatchScanning;
+
+    // Plugins built against the old header do not have the batch members.
+    ScannerPlugin plugin{"fake", "fake", fakeOpen, fakeClose, fakeNext, nullptr, pluginFlags,
+                         batchScanning ? fakeScanBatch : nullptr,
+                         batchScanning ? fakeReleaseBatch : nullptr};
+    fakeScannerStats.openCount = 0;
+    fakeScannerStats.batchCount = 0;
+    fakeScannerStats.maxActiveCalls = 0;
+
+    Artifact artifact;
+    artifact.properties = PropertyMapInternal::create();
+    const int fileCount = 40;
+    std::vector<std::unique_ptr<Artifact>> files;
+    std::vector<FileResourceBase *> filesToScan;
+    for (int i = 0; i < fileCount; ++i) {
+        auto file = std::make_unique<Artifact>();
+        file->setFilePath(QStringLiteral("/src/%1%2.cpp")
+                          .arg(QLatin1String(i % 10 == 9 ? "missing" : "file")).arg(i));
+        filesToScan.push_back(file.get());
+        files.push_back(std::move(file));
+    }
+
+    PluginDependencyScanner pluginScanner(&plugin);
+    DependencyScanner &scanner = pluginScanner;
+    QVERIFY(scanner.supportsBatchScanning());
+    const std::vector<std::optional<QStringList>> dependencies
+            = scanner.collectDependenciesOfFiles(&artifact, filesToScan, "fake");
+    QCOMPARE(dependencies.size(), size_t(fileCount));
+    for (int i = 0; i < fileCount; ++i) {
+        // Files that cannot be scanned must not look like files without dependencies.
+        if (i % 10 == 9) {
+            QVERIFY(!dependencies.at(i));
+            continue;
+        }
+        QCOMPARE(dependencies.at(i),
+                 std::optional<QStringList>(QStringList(QStringLiteral("file%1.h").arg(i))));
+    }
+
+    // Batch scanning replaces the per-file calls, with one call per chunk of 16 files.
+    QCOMPARE(fakeScannerStats.openCount.load(), batchScanning ? 0 : fileCount);
+    QCOMPARE(fakeScannerStats.batchCount.load(), batchScanning ? 3 : 0);
+
+    // Only plugins that declare themselves thread-safe are called concurrently.
+    if (!(pluginFlags & ScannerIsThreadSafe))
+        QCOMPARE(fakeScannerStats.maxActiveCalls.load(), 1);
+    QCOMPARE(fakeScannerStats.activeCalls.load(), 0);
+}
+
 int main(int argc, char *argv[])
 {
     QCoreApplication app(argc, argv);
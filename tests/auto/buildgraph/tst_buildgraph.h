@@ -56,6 +56,8 @@ private slots:
     void initTestCase();
     void cleanupTestCase();
     void testCycle();
+    void testPluginScanner_data();
+    void testPluginScanner();
 
 private:
     qbs::Internal::ResolvedProductConstPtr productWithDirectCycle();
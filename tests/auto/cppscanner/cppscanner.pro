@@ -0,0 +1,16 @@
+TARGET = tst_cppscanner
+
+SCANNER_DIR = ../../../src/plugins/scanner/cpp
+DEFINES += CPLUSPLUS_NO_PARSER
+
+SOURCES = \
+    tst_cppscanner.cpp \
+    $$SCANNER_DIR/Lexer.cpp \
+    $$SCANNER_DIR/Token.cpp \
+    $$SCANNER_DIR/includedirectivefinder.cpp
+HEADERS = \
+    $$SCANNER_DIR/Lexer.h \
+    $$SCANNER_DIR/Token.h \
+    $$SCANNER_DIR/includedirectivefinder.h
+
+include(../auto.pri)
@@ -0,0 +1,238 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qbs.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <plugins/scanner/cpp/Lexer.h>
+#include <plugins/scanner/cpp/includedirectivefinder.h>
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qstringlist.h>
+
+#include <QtTest/qtest.h>
+
+#include <cstring>
+#include <vector>
+
+using namespace CPlusPlus;
+
+// What the scanner plugin did before it had the fast path.
+static QStringList includesFromLexer(const QByteArray &content)
+{
+    const char * const begin = content.constData();
+    const auto equals = [begin](const Token &tk, const char *literal) {
+        return tk.length() == std::strlen(literal)
+                && std::memcmp(begin + tk.begin(), literal, tk.length()) == 0;
+    };
+    QStringList includes;
+    Lexer lexer(begin, begin + content.size());
+    Token tk;
+    lexer(&tk);
+    while (tk.isNot(T_EOF_SYMBOL)) {
+        if (tk.newline() && tk.is(T_POUND)) {
+            lexer(&tk);
+            if (!tk.newline() && tk.is(T_IDENTIFIER)
+                    && (equals(tk, "include") || equals(tk, "import"))) {
+                lexer.setScanAngleStringLiteralTokens(true);
+                lexer(&tk);
+                lexer.setScanAngleStringLiteralTokens(false);
+                if (!tk.newline() && (tk.is(T_STRING_LITERAL) || tk.is(T_ANGLE_STRING_LITERAL)))
+                    includes << QString::fromLatin1(begin + tk.begin(), int(tk.length()));
+            }
+        }
+        lexer(&tk);
+    }
+    return includes;
+}
+
+static QStringList includesFromFastPath(const QByteArray &content)
+{
+    std::vector<IncludeDirective> directives;
+    findIncludeDirectives(content.constData(), content.constData() + content.size(), directives);
+    QStringList includes;
+    for (const IncludeDirective &directive : directives) {
+        const QString fileName = QString::fromLatin1(directive.fileName, directive.size);
+        includes << (directive.isLocal ? '"' + fileName + '"' : '<' + fileName + '>');
+    }
+    return includes;
+}
+
+static QByteArray largeHeader()
+{
+    QByteArray content;
+    for (int i = 0; i < 50000; ++i) {
+        if (i % 100 == 0)
+            content += "#include <header" + QByteArray::number(i) + ".h>\n";
+        content += "static inline int function" + QByteArray::number(i)
+                + "(int a, int b) { return a * b + " + QByteArray::number(i) + "; } // Comment\n";
+    }
+    return content;
+}
+
+class TestCppScanner : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void includeDirectives_data()
+    {
+        QTest::addColumn<QByteArray>("content");
+        QTest::addColumn<QStringList>("expectedIncludes");
+
+        QTest::newRow("simple") << QByteArray("#include <a.h>\n#include \"b.h\"\nint i;\n")
+                                << QStringList{"<a.h>", "\"b.h\""};
+        QTest::newRow("indented, with spaces") << QByteArray("  #  include <a.h>\n\t#import <b.h>")
+                                               << QStringList{"<a.h>", "<b.h>"};
+        QTest::newRow("not at line start") << QByteArray("int i; #include <a.h>\n")
+                                           << QStringList();
+        QTest::newRow("line comment") << QByteArray("// #include <a.h>\n#include <b.h>\n")
+                                      << QStringList{"<b.h>"};
+        QTest::newRow("block comment") << QByteArray("/*\n#include <a.h>\n*/#include <b.h>\n")
+                                       << QStringList{"<b.h>"};
+        QTest::newRow("comment before directive")
+                << QByteArray("/* c */ #include <a.h>\n") << QStringList{"<a.h>"};
+        QTest::newRow("string with escaped newline")
+                << QByteArray("const char *s = \"\\\n#include <a.h>\";\n#include <b.h>\n")
+                << QStringList{"<b.h>"};
+        QTest::newRow("unterminated string") << QByteArray("char c = '\n#include <a.h>\n")
+                                             << QStringList{"<a.h>"};
+        QTest::newRow("wide string literal")
+                << QByteArray("auto s = L\"\n#include <a.h>\n\";\n#include <b.h>\n")
+                << QStringList{"<b.h>"};
+        QTest::newRow("identifier ending in L")
+                << QByteArray("auto s = fooL\"\n#include <a.h>\n")
+                << QStringList{"<a.h>"};
+        QTest::newRow("line continuation") << QByteArray("int i; \\\n#include <a.h>\n")
+                                           << QStringList();
+        QTest::newRow("token pasting") << QByteArray("##include <a.h>\n") << QStringList();
+        QTest::newRow("null byte") << QByteArray("#include <a.h>\n\0#include <b.h>\n", 31)
+                                   << QStringList{"<a.h>"};
+    }
+
+    void includeDirectives()
+    {
+        QFETCH(QByteArray, content);
+        QFETCH(QStringList, expectedIncludes);
+        QCOMPARE(includesFromLexer(content), expectedIncludes);
+        QCOMPARE(includesFromFastPath(content), expectedIncludes);
+    }
+
+    void moduleDirectives_data()
+    {
+        QTest::addColumn<QByteArray>("content");
+        QTest::addColumn<QString>("expectedModule");
+        QTest::addColumn<QStringList>("expectedImports");
+        QTest::addColumn<QStringList>("expectedIncludes");
+
+        QTest::newRow("interface unit")
+                << QByteArray("module;\n#include <a.h>\nexport module m.n;\nimport o;\n"
+                              "export import :p;\nint i;\n")
+                << QString("m.n") << QStringList{"o", "m.n:p"} << QStringList{"<a.h>"};
+        QTest::newRow("implementation unit")
+                << QByteArray("module m;\nimport n;\n")
+                << QString("m") << QStringList{"m", "n"} << QStringList();
+        QTest::newRow("partition")
+                << QByteArray("module m:p;\nimport :q;\n")
+                << QString("m") << QStringList{"m:q"} << QStringList();
+        QTest::newRow("header units")
+                << QByteArray("import <a.h>;\nexport import \"b.h\";\n")
+                << QString() << QStringList() << QStringList{"<a.h>", "\"b.h\""};
+        QTest::newRow("attributes and comments")
+                << QByteArray("/* c */ export module m [[a]]; // c\n  import n [[b]];\n")
+                << QString("m") << QStringList{"n"} << QStringList();
+        QTest::newRow("not declarations")
+                << QByteArray("int import = 1;\nimport(x);\nexport int f();\nmodule = 2;\n"
+                              "import n\n;\nmodule :private;\nint i; import o;\n")
+                << QString() << QStringList() << QStringList();
+        QTest::newRow("partition outside of module")
+                << QByteArray("import :p;\n") << QString() << QStringList() << QStringList();
+    }
+
+    void moduleDirectives()
+    {
+        QFETCH(QByteArray, content);
+        QFETCH(QString, expectedModule);
+        QFETCH(QStringList, expectedImports);
+        QFETCH(QStringList, expectedIncludes);
+        std::vector<IncludeDirective> directives;
+        ModuleDirectives modules;
+        findIncludeDirectives(content.constData(), content.constData() + content.size(),
+                              directives, &modules);
+        QStringList includes;
+        for (const IncludeDirective &directive : directives) {
+            const QString fileName = QString::fromLatin1(directive.fileName, directive.size);
+            includes << (directive.isLocal ? '"' + fileName + '"' : '<' + fileName + '>');
+        }
+        QStringList imports;
+        for (const std::string &moduleName : modules.imports)
+            imports << QString::fromStdString(moduleName);
+        QCOMPARE(QString::fromStdString(modules.declaredModule), expectedModule);
+        QCOMPARE(imports, expectedImports);
+        QCOMPARE(includes, expectedIncludes);
+
+        // Without the module support, the include directives are found as before.
+        QCOMPARE(includesFromFastPath(content), includesFromLexer(content));
+    }
+
+    void largeFile()
+    {
+        const QByteArray content = largeHeader();
+        QCOMPARE(includesFromFastPath(content), includesFromLexer(content));
+    }
+
+    void benchmark_data()
+    {
+        QTest::addColumn<bool>("useFastPath");
+        QTest::newRow("lexer") << false;
+        QTest::newRow("fast path") << true;
+    }
+
+    void benchmark()
+    {
+        QFETCH(bool, useFastPath);
+        const QByteArray content = largeHeader();
+        QStringList includes;
+        QBENCHMARK {
+            includes = useFastPath ? includesFromFastPath(content) : includesFromLexer(content);
+        }
+        QCOMPARE(includes.size(), 500);
+    }
+};
+
+QTEST_MAIN(TestCppScanner)
+
+#include "tst_cppscanner.moc"
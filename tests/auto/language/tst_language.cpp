@@ -319,6 +319,32 @@ void TestLanguage::chainedProbes()
 
 }
 
+void TestLanguage::variantFingerprints_data()
+{
+    QTest::addColumn<QVariant>("value1");
+    QTest::addColumn<QVariant>("value2");
+    QTest::newRow("nested maps")
+            << QVariant(QVariantMap{{"a", QVariantMap{{"x", 1}}}, {"y", 2}})
+            << QVariant(QVariantMap{{"a", QVariantMap{{"x", 1}, {"y", 2}}}});
+    QTest::newRow("nested lists")
+            << QVariant(QVariantList{QStringList{"a"}, "b"})
+            << QVariant(QVariantList{QStringList{"a", "b"}});
+    QTest::newRow("empty lists")
+            << QVariant(QVariantList{QVariantList(), QVariantList()})
+            << QVariant(QVariantList{QVariantList{QVariantList()}});
+    QTest::newRow("empty maps")
+            << QVariant(QVariantMap{{"a", QVariantMap()}, {"b", QVariantMap()}})
+            << QVariant(QVariantMap{{"a", QVariantMap{{"b", QVariantMap()}}}});
+}
+
+void TestLanguage::variantFingerprints()
+{
+    QFETCH(QVariant, value1);
+    QFETCH(QVariant, value2);
+    QVERIFY(value1 != value2);
+    QVERIFY(variantFingerprint(value1) != variantFingerprint(value2));
+}
+
 void TestLanguage::versionCompare()
 {
     bool exceptionCaught = false;
@@ -1682,6 +1708,53 @@ void TestLanguage::jsImportUsedInMultipleScopes()
     QVERIFY(!exceptionCaught);
 }
 
+void TestLanguage::memoizedModuleBindings()
+{
+    bool exceptionCaught = false;
+    try {
+        SetupProjectParameters params = defaultParameters;
+        params.setProjectFilePath(testProject("memoized-module-bindings.qbs"));
+        const int hitsBefore = m_engine->memoizedBindingHits();
+        const TopLevelProjectPtr project = loader->loadProject(params);
+        QVERIFY(!!project);
+        const QHash<QString, ResolvedProductPtr> products = productsFromProject(project);
+        QCOMPARE(products.size(), 4);
+
+        // The module prototype's bindings are shared by all products, but a memoized result
+        // must only be re-used if the values it depends on are the same.
+        const auto moduleValue = [&products](const QString &productName,
+                                             const QString &propertyName) {
+            const ResolvedProductConstPtr product = products.value(productName);
+            return product ? product->moduleProperties->moduleProperty("dummy", propertyName)
+                           : QVariant();
+        };
+        for (const QString &productName : {QStringLiteral("a"), QStringLiteral("b"),
+                                           QStringLiteral("c"), QStringLiteral("d")}) {
+            QCOMPARE(moduleValue(productName, "productName").toString(), productName);
+            QCOMPARE(moduleValue(productName, "upperCaseProductName").toString(),
+                     productName.toUpper());
+        }
+        QCOMPARE(moduleValue("a", "listProp").toStringList(), QStringList("456"));
+        QCOMPARE(moduleValue("b", "listProp").toStringList(), QStringList("123"));
+        QCOMPARE(moduleValue("c", "listProp").toStringList(), QStringList("456"));
+        QCOMPARE(moduleValue("d", "listProp").toStringList(), QStringList("456"));
+        QCOMPARE(moduleValue("a", "listProp2").toStringList(), QStringList("DEFAULT_STUFF"));
+        QCOMPARE(moduleValue("b", "listProp2").toStringList(), QStringList("DEFAULT_STUFF"));
+        QCOMPARE(moduleValue("c", "listProp2").toStringList(),
+                 QStringList({"DEFAULT_STUFF", "EXTRA_STUFF"}));
+        QCOMPARE(moduleValue("d", "listProp2").toStringList(), QStringList("DEFAULT_STUFF"));
+
+        // Bindings that only depend on values that are the same in all products must not
+        // have been evaluated again for each of them.
+        QVERIFY(m_engine->memoizedBindingHits() > hitsBefore);
+    }
+    catch (const ErrorInfo &e) {
+        exceptionCaught = true;
+        qDebug() << e.toString();
+    }
+    QCOMPARE(exceptionCaught, false);
+}
+
 void TestLanguage::moduleMergingVariantValues()
 {
     bool exceptionCaught = false;
@@ -129,6 +129,7 @@ private slots:
     void jsExtensions();
     void jsImportUsedInMultipleScopes_data();
     void jsImportUsedInMultipleScopes();
+    void memoizedModuleBindings();
     void moduleMergingVariantValues();
     void modulePrioritizationBySearchPath_data();
     void modulePrioritizationBySearchPath();
@@ -178,6 +179,8 @@ private slots:
     void recursiveProductDependencies();
     void rfc1034Identifier();
     void useInternalProfile();
+    void variantFingerprints_data();
+    void variantFingerprints();
     void versionCompare();
     void wildcards_data();
     void wildcards();
@@ -47,6 +47,7 @@
 #include <tools/error.h>
 #include <tools/fileinfo.h>
 #include <tools/filesaver.h>
+#include <tools/flatmap.h>
 #include <tools/hostosinfo.h>
 #include <tools/processutils.h>
 #include <tools/profile.h>
@@ -59,6 +60,7 @@
 #include <QtCore/qdir.h>
 #include <QtCore/qfile.h>
 #include <QtCore/qfileinfo.h>
+#include <QtCore/qmap.h>
 #include <QtCore/qsettings.h>
 #include <QtCore/qtemporarydir.h>
 #include <QtCore/qtemporaryfile.h>
@@ -1309,6 +1311,118 @@ void TestTools::stringutils_trimmed()
     QCOMPARE(trimmed(std::move(a)), std::string("a"));
 }
 
+void TestTools::flatmap_insertAndFind()
+{
+    FlatMap<QString, int> map;
+    QVERIFY(map.isEmpty());
+    QVERIFY(map.find(QStringLiteral("a")) == map.end());
+
+    for (int j = 0; j < 500; ++j) {
+        const int i = (j * 17) % 500;
+        QVERIFY(!map.contains(QString::number(i)));
+        const auto it = map.insert(QString::number(i), i);
+        QCOMPARE(it.key(), QString::number(i));
+        QCOMPARE(it.value(), i);
+        QVERIFY(map.contains(QString::number(i)));
+    }
+    QCOMPARE(map.size(), 500);
+
+    for (int i = 0; i < 500; ++i) {
+        const auto it = map.find(QString::number(i));
+        QVERIFY(it != map.end());
+        QCOMPARE(*it, i);
+        QCOMPARE(map.value(QString::number(i)), i);
+    }
+    QCOMPARE(map.value(QStringLiteral("x"), -1), -1);
+
+    // Inserting an existing key replaces the value.
+    map.insert(QStringLiteral("7"), 70);
+    QCOMPARE(map.size(), 500);
+    QCOMPARE(map.value(QStringLiteral("7")), 70);
+    map[QStringLiteral("7")] = 700;
+    QCOMPARE(map.value(QStringLiteral("7")), 700);
+    map[QStringLiteral("x")] += 1;
+    QCOMPARE(map.size(), 501);
+    QCOMPARE(map.value(QStringLiteral("x")), 1);
+}
+
+void TestTools::flatmap_iterationOrder()
+{
+    FlatMap<QString, int> map;
+    QMap<QString, int> qmap;
+    for (const QString &key : {QStringLiteral("c"), QStringLiteral("a"), QStringLiteral("bb"),
+                               QStringLiteral("b"), QStringLiteral("A")}) {
+        map.insert(key, key.size());
+        qmap.insert(key, key.size());
+    }
+    QCOMPARE(map.keys(), qmap.keys());
+    QCOMPARE(map.values(), qmap.values());
+
+    QStringList keys;
+    for (auto it = map.cbegin(); it != map.cend(); ++it)
+        keys << it.key();
+    QCOMPARE(keys, qmap.keys());
+
+    keys.clear();
+    for (auto it = map.end(); it != map.begin();)
+        keys.prepend((--it).key());
+    QCOMPARE(keys, qmap.keys());
+
+    for (int &value : map)
+        value *= 2;
+    QCOMPARE(map.value(QStringLiteral("bb")), 4);
+}
+
+void TestTools::flatmap_remove()
+{
+    FlatMap<int, int> map;
+    for (int i = 0; i < 10; ++i)
+        map.insert(i, i * i);
+    QCOMPARE(map.remove(42), 0);
+    QCOMPARE(map.remove(3), 1);
+    QCOMPARE(map.remove(3), 0);
+    QCOMPARE(map.size(), 9);
+    QVERIFY(!map.contains(3));
+
+    auto it = map.erase(map.constFind(4));
+    QVERIFY(it != map.end());
+    QCOMPARE(it.key(), 5);
+    it = map.erase(map.constFind(9));
+    QVERIFY(it == map.end());
+    QCOMPARE(map.keys(), QList<int>({0, 1, 2, 5, 6, 7, 8}));
+
+    map.clear();
+    QVERIFY(map.empty());
+    QCOMPARE(map.count(), 0);
+}
+
+void TestTools::flatmap_implicitSharing()
+{
+    FlatMap<QString, int> map;
+    for (int i = 0; i < 100; ++i)
+        map.insert(QString::number(i), i);
+    const FlatMap<QString, int> copy = map;
+    QVERIFY(copy == map);
+
+    // A non-const find() on a shared map detaches it. The returned iterator must refer
+    // to the map's own data, not to the data it shares with the copy.
+    const auto it = map.find(QStringLiteral("42"));
+    QVERIFY(it != map.end());
+    QCOMPARE(it.key(), QStringLiteral("42"));
+    *it = -42;
+    QCOMPARE(map.value(QStringLiteral("42")), -42);
+    QCOMPARE(copy.value(QStringLiteral("42")), 42);
+    QVERIFY(copy != map);
+
+    FlatMap<QString, int> copy2 = copy;
+    copy2[QStringLiteral("0")] = -1;
+    QCOMPARE(copy.value(QStringLiteral("0")), 0);
+    QCOMPARE(copy2.value(QStringLiteral("0")), -1);
+    copy2.remove(QStringLiteral("1"));
+    QVERIFY(copy.contains(QStringLiteral("1")));
+    QCOMPARE(copy.size(), 100);
+}
+
 void TestTools::hash_tuple()
 {
     using Key = std::tuple<int, int>;
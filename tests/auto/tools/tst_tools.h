@@ -100,6 +100,11 @@ private slots:
     void stringutils_endsWith();
     void stringutils_trimmed();
 
+    void flatmap_insertAndFind();
+    void flatmap_iterationOrder();
+    void flatmap_remove();
+    void flatmap_implicitSharing();
+
     void hash_tuple();
     void hash_range();
 